@@ -37,14 +37,43 @@
 #include <cstring>
 #include <algorithm>
 #include <vector>
+#include <list>
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <chrono>
 #include <cstring>
 #include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <initializer_list>
+#include <new>
 #include <ctime>
+#include <charconv>
 #include <unistd.h>
+#ifdef __linux__
+ #include <sys/eventfd.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+ #include <emmintrin.h>
+ #define SHL_GTK_SSE2
+#endif
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+ #if __has_include(<coroutine>)
+  #include <coroutine>
+  #define SHL_GTK_COROUTINE
+ #endif
+#endif
 #include <gtkmm.h>
 #include <gtkmm/switch.h>
 
@@ -142,2810 +171,6929 @@ namespace base  // shl::gtk::base
   };
 
   // ===========================================================================
-  //  EventData class
+  //  RingBuffer class
   // ===========================================================================
-  class EventData
+  // Bounded lock-free multi-producer ring. Each slot carries a sequence number
+  // (Vyukov style), so producers only contend on one CAS and never take a lock.
+  // pop() is for a single consumer, pop_shared() can be used by many.
+  //
+  template <class T> class RingBuffer
   {
   public:
     // -------------------------------------------------------------------------
-    // EventData destructor
+    // RingBuffer constructor
     // -------------------------------------------------------------------------
-    virtual ~EventData() = default;
+    // [Note] in_capacity will be rounded up to the power of two
+    //
+    explicit RingBuffer(size_t in_capacity) :
+        m_enqueue_pos(0),
+        m_dequeue_pos(0)
+    {
+      size_t capacity = 2;
+      while (capacity < in_capacity)
+        capacity <<= 1;
+      m_mask = capacity - 1;
+      m_slots = new Slot[capacity];
+      for (size_t i = 0; i < capacity; i++)
+        m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
     // -------------------------------------------------------------------------
-    // get_source
+    // RingBuffer destructor
     // -------------------------------------------------------------------------
-    virtual void *get_source()
+    virtual ~RingBuffer()
     {
-      return m_source;
+      delete[] m_slots;
     }
-
-  protected:
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // EventData constructor
+    // push (can be called from any thread)
     // -------------------------------------------------------------------------
-    EventData(void *in_source, void (*in_handler)(EventData *)) :
-        m_source(in_source),
-        m_handler(in_handler)
+    bool push(const T &in_item)
     {
+      size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        Slot *slot = &(m_slots[pos & m_mask]);
+        size_t seq = slot->m_sequence.load(std::memory_order_acquire);
+        auto diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0)
+        {
+          if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed))
+          {
+            slot->m_item = in_item;
+            slot->m_sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (diff < 0)
+          return false; // full
+        else
+          pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
     }
-    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // is_same_source
+    // pop (must be called from the single consumer)
     // -------------------------------------------------------------------------
-    virtual bool is_same_source(EventData *in_event_data)
+    bool pop(T *out_item)
     {
-      if (m_source == in_event_data->m_source &&
-          m_handler       == in_event_data->m_handler)
-        return true;
-      return false;
+      size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      Slot *slot = &(m_slots[pos & m_mask]);
+      size_t seq = slot->m_sequence.load(std::memory_order_acquire);
+      if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+        return false; // empty (or a producer has not published yet)
+      *out_item = slot->m_item;
+      slot->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+      m_dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+      return true;
     }
     // -------------------------------------------------------------------------
-    // invoke_handler
+    // pop_shared (can be called from any thread)
     // -------------------------------------------------------------------------
-    virtual void invoke_handler()
+    bool pop_shared(T *out_item)
     {
-      if (m_handler != nullptr)
-        m_handler(this);
+      size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        Slot *slot = &(m_slots[pos & m_mask]);
+        size_t seq = slot->m_sequence.load(std::memory_order_acquire);
+        auto diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0)
+        {
+          if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed))
+          {
+            *out_item = slot->m_item;
+            slot->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (diff < 0)
+          return false; // empty
+        else
+          pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    // -------------------------------------------------------------------------
+    // size (approximate when producers are running)
+    // -------------------------------------------------------------------------
+    size_t size() const
+    {
+      size_t enqueue_pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      size_t dequeue_pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      if (enqueue_pos < dequeue_pos)
+        return 0;
+      return enqueue_pos - dequeue_pos;
+    }
+    // -------------------------------------------------------------------------
+    // empty
+    // -------------------------------------------------------------------------
+    bool empty() const
+    {
+      return size() == 0;
+    }
+    // -------------------------------------------------------------------------
+    // capacity
+    // -------------------------------------------------------------------------
+    size_t capacity() const
+    {
+      return m_mask + 1;
     }
 
   private:
+    // member types ------------------------------------------------------------
+    struct Slot
+    {
+      std::atomic<size_t> m_sequence;
+      T m_item;
+    };
     // member variables --------------------------------------------------------
-    void  *m_source;
-    void (*m_handler)(EventData *);
-
-    // friend classes ----------------------------------------------------------
-    friend class EventQueue;
-    friend class WindowBase;
+    Slot    *m_slots;
+    size_t  m_mask;
+    alignas(64) std::atomic<size_t> m_enqueue_pos;
+    alignas(64) std::atomic<size_t> m_dequeue_pos;
   };
 
   // ===========================================================================
-  //  EventQueue class
+  //  EventPool class
   // ===========================================================================
-  class EventQueue
+  // Per-queue free-list of fixed size blocks for EventData (and subclasses).
+  // Every block starts with a small header that records the owner pool, so a
+  // plain "delete event" returns the block to where it came from.
+  //
+  class EventPool
   {
   public:
+    // constants ---------------------------------------------------------------
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t BLOCK_SIZE  = 128;  // including HEADER_SIZE
+    static constexpr size_t DEFAULT_FREE_NUM  = 1024;
+
+    // member types ------------------------------------------------------------
+    struct Stats
+    {
+      size_t m_hit_num;       // served from the free-list
+      size_t m_miss_num;      // needed a heap allocation
+      size_t m_oversize_num;  // (included in m_miss_num) larger than a block
+      size_t m_free_num;      // blocks currently cached in the free-list
+    };
+
     // -------------------------------------------------------------------------
-    // EventQueue constructor
-    // -------------------------------------------------------------------------
-    EventQueue() = default;
-    // -------------------------------------------------------------------------
-    // EventQueue destructor
+    // EventPool constructor
     // -------------------------------------------------------------------------
-    virtual ~EventQueue() = default;
-    // Member functions --------------------------------------------------------
+    explicit EventPool(size_t in_max_free_num = DEFAULT_FREE_NUM) :
+        m_free_list(in_max_free_num),
+        m_hit_num(0),
+        m_miss_num(0),
+        m_oversize_num(0)
+    {
+    }
     // -------------------------------------------------------------------------
-    // push
+    // EventPool destructor
     // -------------------------------------------------------------------------
-    void push(void *in_source, void (*in_handler)(EventData *))
+    virtual ~EventPool()
     {
-      auto *event = new EventData(in_source, in_handler);
-      push(event);
+      void *block;
+      while (m_free_list.pop_shared(&block))
+        ::operator delete(block);
     }
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // push
+    // reserve
     // -------------------------------------------------------------------------
-    void push(EventData *in_event)
+    void reserve(size_t in_num)
     {
-      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
-      m_event_data_queue.push_back(in_event);
-      m_new_event_cond.notify_all();
+      for (size_t i = 0; i < in_num; i++)
+      {
+        void *block = ::operator new(BLOCK_SIZE);
+        if (m_free_list.push(block) == false)
+        {
+          ::operator delete(block);
+          break;
+        }
+      }
     }
     // -------------------------------------------------------------------------
-    // notify
+    // get_stats
     // -------------------------------------------------------------------------
-    void notify()
+    Stats get_stats() const
     {
-      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
-      m_new_event_cond.notify_all();
+      Stats stats;
+      stats.m_hit_num = m_hit_num.load(std::memory_order_relaxed);
+      stats.m_miss_num = m_miss_num.load(std::memory_order_relaxed);
+      stats.m_oversize_num = m_oversize_num.load(std::memory_order_relaxed);
+      stats.m_free_num = m_free_list.size();
+      return stats;
     }
     // -------------------------------------------------------------------------
-    // wait
+    // reset_stats
     // -------------------------------------------------------------------------
-    void wait()
+    void reset_stats()
     {
-      std::unique_lock<std::mutex> lock(m_event_queue_mutex);
-      if (m_event_data_queue.empty() == false)
-        return;
-      m_new_event_cond.wait(lock);
+      m_hit_num.store(0, std::memory_order_relaxed);
+      m_miss_num.store(0, std::memory_order_relaxed);
+      m_oversize_num.store(0, std::memory_order_relaxed);
     }
+
+    // static functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // process_events
+    // alloc_block (in_pool can be nullptr = plain heap allocation)
     // -------------------------------------------------------------------------
-    void process_events(bool in_last_only = false)
+    static void *alloc_block(EventPool *in_pool, size_t in_size)
     {
-      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
-      while (m_event_data_queue.empty() == false)
+      void *block = nullptr;
+      if (in_pool != nullptr)
       {
-        bool skip = false;
-        EventData *event_data = m_event_data_queue.front();
-        if (in_last_only)
+        if (HEADER_SIZE + in_size <= BLOCK_SIZE)
         {
-          auto it = m_event_data_queue.begin();
-          it++;
-          while (it != m_event_data_queue.end())
+          if (in_pool->m_free_list.pop_shared(&block))
+            in_pool->m_hit_num.fetch_add(1, std::memory_order_relaxed);
+          else
           {
-            if (event_data->is_same_source(*it))
-            {
-              skip = true;
-              break;
-            }
-            it++;
+            block = ::operator new(BLOCK_SIZE);
+            in_pool->m_miss_num.fetch_add(1, std::memory_order_relaxed);
           }
+          *((EventPool **)block) = in_pool;
+          return (char *)block + HEADER_SIZE;
         }
-        if (skip == false)
-          event_data->invoke_handler();
-        m_event_data_queue.pop_front();
-        delete event_data;
+        in_pool->m_miss_num.fetch_add(1, std::memory_order_relaxed);
+        in_pool->m_oversize_num.fetch_add(1, std::memory_order_relaxed);
       }
+      block = ::operator new(HEADER_SIZE + in_size);
+      *((EventPool **)block) = nullptr;
+      return (char *)block + HEADER_SIZE;
+    }
+    // -------------------------------------------------------------------------
+    // free_block
+    // -------------------------------------------------------------------------
+    static void free_block(void *in_ptr)
+    {
+      if (in_ptr == nullptr)
+        return;
+      void *block = (char *)in_ptr - HEADER_SIZE;
+      EventPool *pool = *((EventPool **)block);
+      if (pool != nullptr && pool->m_free_list.push(block))
+        return;
+      ::operator delete(block);
     }
 
   private:
     // member variables --------------------------------------------------------
-    std::list<EventData *>  m_event_data_queue;
-    std::condition_variable m_new_event_cond;
-    std::mutex  m_event_queue_mutex;
+    RingBuffer<void *>  m_free_list;
+    std::atomic<size_t> m_hit_num;
+    std::atomic<size_t> m_miss_num;
+    std::atomic<size_t> m_oversize_num;
   };
 
   // ===========================================================================
-  //  TimerData class
+  //  Callback class
   // ===========================================================================
-  class TimerData
+  // Type-erased callable stored in a fixed in-place buffer (never allocates).
+  // A callable larger than BUFFER_SIZE is a compile error (capture a pointer
+  // or a reference instead)
+  //
+  template <typename Signature, size_t BUFFER_SIZE = 48> class Callback;
+
+  template <typename R, typename... Args, size_t BUFFER_SIZE>
+  class Callback<R(Args...), BUFFER_SIZE>
   {
-  protected:
+  public:
     // -------------------------------------------------------------------------
-    // TimerData constructor
+    // Callback constructor
     // -------------------------------------------------------------------------
-    TimerData( unsigned int in_interval_ms,
-                EventQueue *in_user_event_queue,
-                void (*in_timer_event_func)(void *in_user_data),
-                void *in_user_data = nullptr) :
-        m_interval_ms(in_interval_ms),
-        m_user_event_queue(in_user_event_queue),
-        m_timer_event_func(in_timer_event_func),
-        m_user_data(in_user_data),
-        m_is_running(false)
+    Callback() :
+        m_invoke(nullptr),
+        m_destroy(nullptr)
     {
     }
+    Callback(const Callback &) = delete;
+    Callback &operator=(const Callback &) = delete;
     // -------------------------------------------------------------------------
-    // WidgetData destructor
+    // Callback destructor
     // -------------------------------------------------------------------------
-    virtual ~TimerData() = default;
+    ~Callback()
+    {
+      reset();
+    }
     // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // connect (needs to be called from the UI thread)
+    // assign
     // -------------------------------------------------------------------------
-    void connect()
+    template <typename F> void assign(F &&in_func)
     {
-      mTimerConnection = Glib::signal_timeout().connect(
-              sigc::mem_fun(*this, &TimerData::queue_timer_event), m_interval_ms);
-      m_is_running = true;
-      // todo : add connect_seconds() path also
+      typedef typename std::decay<F>::type Func;
+      static_assert(sizeof(Func) <= BUFFER_SIZE,
+                    "Callback: the callable is too large for the buffer");
+      static_assert(alignof(Func) <= alignof(std::max_align_t),
+                    "Callback: the callable is over-aligned");
+      reset();
+      new (m_buffer) Func(std::forward<F>(in_func));
+      m_invoke = [](void *in_buffer, Args... in_args) -> R
+      {
+        return (*(Func *)in_buffer)(std::forward<Args>(in_args)...);
+      };
+      m_destroy = [](void *in_buffer)
+      {
+        ((Func *)in_buffer)->~Func();
+      };
     }
     // -------------------------------------------------------------------------
-    // disconnect (needs to be called from the UI thread)
+    // reset
     // -------------------------------------------------------------------------
-    void disconnect()
+    void reset()
     {
-      if (m_is_running == false)
-        return;
-      mTimerConnection.disconnect();
-      m_is_running = false;
+      if (m_destroy != nullptr)
+        m_destroy(m_buffer);
+      m_invoke = nullptr;
+      m_destroy = nullptr;
     }
     // -------------------------------------------------------------------------
-    // queue_timer_event
+    // is_set
     // -------------------------------------------------------------------------
-    bool queue_timer_event()
+    bool is_set() const
     {
-      if (m_user_event_queue == nullptr || m_timer_event_func == nullptr)
-        return false; // return false = disconnect
-
-      m_user_event_queue->push(this, process_timer_event);
-      return true;  
+      return m_invoke != nullptr;
     }
-    // -------------------------------------------------------------------------
-    // process_timer_event
-    // -------------------------------------------------------------------------
-    static void process_timer_event(base::EventData *in_event)
+    // operators ---------------------------------------------------------------
+    explicit operator bool() const
     {
-      auto  *timer = (TimerData *)in_event->get_source();
-      timer->m_timer_event_func(timer->m_user_data);
+      return is_set();
+    }
+    R operator()(Args... in_args)
+    {
+      return m_invoke(m_buffer, std::forward<Args>(in_args)...);
     }
 
   private:
     // member variables --------------------------------------------------------
-    unsigned int  m_interval_ms;
-    void (*m_timer_event_func)(void *in_user_data);
-    void *m_user_data;
-    EventQueue *m_user_event_queue;
-    sigc::connection  mTimerConnection;
-    bool  m_is_running;
-
-    friend class BackgroundApp;
-    friend class WindowBase;
+    alignas(std::max_align_t) unsigned char m_buffer[BUFFER_SIZE];
+    R (*m_invoke)(void *, Args...);
+    void (*m_destroy)(void *);
   };
 
   // ===========================================================================
-  //  BackgroundApp class
+  //  SeqLockString class
   // ===========================================================================
-  class BackgroundApp : public Gtk::Application
+  // Single-writer string mirror that readers copy without taking a lock.
+  // Text up to INLINE_SIZE bytes is kept inline (as atomic words) and guarded
+  // by a sequence counter; the reader retries while a store is in progress.
+  // Longer text falls back to a mutex protected std::string.
+  // [Note] store() must only be called from one thread (the GTK thread)
+  //
+  class SeqLockString
   {
   public:
+    static const size_t INLINE_SIZE = 256;
+
     // -------------------------------------------------------------------------
-    // BackgroundApp destructor
+    // SeqLockString constructor
     // -------------------------------------------------------------------------
-    ~BackgroundApp() override
+    SeqLockString() :
+        m_sequence(0), m_length(0)
     {
-      SHL_DBG_OUT("BackgroundApp was deleted");
+      for (auto &word : m_words)
+        word.store(0, std::memory_order_relaxed);
     }
-
-  protected:
     // -------------------------------------------------------------------------
-    // BackgroundApp constructor
+    // SeqLockString destructor
     // -------------------------------------------------------------------------
-    BackgroundApp() :
-            Gtk::Application("org.gtkmm.examples.application",
-                             Gio::APPLICATION_NON_UNIQUE),
-                             m_quit(false)
-    {
-    }
+    virtual ~SeqLockString() = default;
 
     // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // post_create_window
+    // store
     // -------------------------------------------------------------------------
-    // [Note] this function will be called from another thread
-    //
-    void post_create_window(BackgroundAppWindowInterface *in_interface, const char *in_title)
+    void store(const std::string &in_text)
     {
-      std::lock_guard<std::mutex> lock(m_create_win_queue_mutex);
-      m_create_win_queue.push(in_interface);
-      m_win_title_queue.push(in_title);
-      // Invoke one time on_idle call (by returning false from the signal handler)
-      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
+      size_t length = in_text.size();
+      uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+      m_sequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      if (length > INLINE_SIZE)
+      {
+        std::lock_guard<std::mutex> lock(m_long_mutex);
+        m_long_text = in_text;
+      }
+      else
+      {
+        for (size_t i = 0; i < length; i += sizeof(uint64_t))
+        {
+          uint64_t word = 0;
+          std::memcpy(&word, in_text.data() + i,
+                      std::min(sizeof(uint64_t), length - i));
+          m_words[i / sizeof(uint64_t)].store(word, std::memory_order_relaxed);
+        }
+      }
+      m_length.store(length, std::memory_order_relaxed);
+      m_sequence.store(sequence + 2, std::memory_order_release);
     }
     // -------------------------------------------------------------------------
-    // post_delete_window
+    // load
     // -------------------------------------------------------------------------
-    // [Note] this function will be called from another thread
+    // [Note] returns false when in_compare is set and *io_text is unchanged
     //
-    void post_delete_window(BackgroundAppWindowInterface *in_interface)
+    bool load(std::string *io_text, bool in_compare = false) const
     {
-      std::lock_guard<std::mutex> lock(m_delete_win_queue_mutex);
-      m_delete_win_queue.push(in_interface);
-      // Invoke one time on_idle call (by returning false from the signal handler)
-      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
+      char buffer[INLINE_SIZE];
+      while (true)
+      {
+        uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0)
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        size_t length = m_length.load(std::memory_order_relaxed);
+        if (length > INLINE_SIZE)
+        {
+          std::string text;
+          {
+            std::lock_guard<std::mutex> lock(m_long_mutex);
+            text = m_long_text;
+          }
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (m_sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+          if (in_compare && *io_text == text)
+            return false;
+          io_text->swap(text);
+          return true;
+        }
+        for (size_t i = 0; i < length; i += sizeof(uint64_t))
+        {
+          uint64_t word = m_words[i / sizeof(uint64_t)].load(std::memory_order_relaxed);
+          std::memcpy(buffer + i, &word, std::min(sizeof(uint64_t), length - i));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != sequence)
+          continue;
+        if (in_compare && io_text->compare(0, std::string::npos, buffer, length) == 0)
+          return false;
+        io_text->assign(buffer, length);
+        return true;
+      }
     }
     // -------------------------------------------------------------------------
-    // post_update_window
+    // get_sequence
     // -------------------------------------------------------------------------
-    // [Note] this function will be called from another thread
+    // [Note] increases by 2 with every store()
     //
-    void post_update_window(BackgroundAppWindowInterface *in_interface)
+    uint64_t get_sequence() const
     {
-      std::lock_guard<std::mutex> lock(m_update_win_queue_mutex);
-      m_update_win_queue.push(in_interface);
-      // Invoke one time on_idle call (by returning false from the signal handler)
-      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
+      return m_sequence.load(std::memory_order_acquire);
     }
+
+  private:
+    // member variables --------------------------------------------------------
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<size_t>   m_length;
+    std::atomic<uint64_t> m_words[INLINE_SIZE / sizeof(uint64_t)];
+    std::string         m_long_text;
+    mutable std::mutex  m_long_mutex;
+  };
+
+  // ===========================================================================
+  //  DirtyBitmap class
+  // ===========================================================================
+  // Two-level atomic bitmap. set() marks one index from any thread and
+  // take() collects and clears the marked indices at O(summary words +
+  // marked indices) cost: a summary bit is set for every non-zero leaf word,
+  // so clean leaf words are never read.
+  // [Note] resize() must not run concurrently with set() or take()
+  //
+  class DirtyBitmap
+  {
+  public:
     // -------------------------------------------------------------------------
-    // post_connect_timer
+    // DirtyBitmap constructor
     // -------------------------------------------------------------------------
-    // [Note] this function will be called from another thread
-    //
-    void post_connect_timer(TimerData *inTimerData)
+    DirtyBitmap() :
+        m_size(0), m_leaf_num(0), m_summary_num(0),
+        m_leaves(nullptr), m_summaries(nullptr)
     {
-      std::lock_guard<std::mutex> lock(m_connect_timer_queue_mutex);
-      m_connect_timer_queue.push(inTimerData);
-      // Invoke one time on_idle call (by returning false from the signal handler)
-      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
     }
     // -------------------------------------------------------------------------
-    // post_disconnect_timer
+    // DirtyBitmap destructor
     // -------------------------------------------------------------------------
-    // [Note] this function will be called from another thread
-    //
-    void post_disconnect_timer(TimerData *inTimerData)
+    virtual ~DirtyBitmap()
     {
-      std::lock_guard<std::mutex> lock(m_disconnect_timer_queue_mutex);
-      m_disconnect_timer_queue.push(inTimerData);
-      // Invoke one time on_idle call (by returning false from the signal handler)
-      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
+      delete[] m_leaves;
+      delete[] m_summaries;
     }
+
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // post_quit_app
+    // resize
     // -------------------------------------------------------------------------
-    // [Note] this function will be called from another thread
-    //
-    void post_quit_app()
+    void resize(size_t in_size)
     {
-      std::lock_guard<std::mutex> lock(m_create_win_queue_mutex);
-      m_quit = true;
-      // Invoke one time on_idle call (by returning false from the signal handler)
-      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
+      size_t leaf_num = (in_size + 63) / 64;
+      size_t summary_num = (leaf_num + 63) / 64;
+      if (leaf_num > m_leaf_num)
+        m_leaves = grow(m_leaves, m_leaf_num, leaf_num);
+      if (summary_num > m_summary_num)
+        m_summaries = grow(m_summaries, m_summary_num, summary_num);
+      m_leaf_num = std::max(m_leaf_num, leaf_num);
+      m_summary_num = std::max(m_summary_num, summary_num);
+      m_size = in_size;
     }
     // -------------------------------------------------------------------------
-    // get_window_num
+    // size
     // -------------------------------------------------------------------------
-    size_t get_window_num()
+    size_t size() const
     {
-      return m_window_list.size();
+      return m_size;
     }
     // -------------------------------------------------------------------------
-    // wait_window_all_closed
+    // set
     // -------------------------------------------------------------------------
-    void wait_window_all_closed()
+    void set(size_t in_index)
     {
-      std::unique_lock<std::mutex> window_lock(m_window_mutex);
-      if (get_window_num() == 0)
+      if (in_index >= m_size)
         return;
-      m_window_cond.wait(window_lock);
+      size_t leaf = in_index / 64;
+      uint64_t bit = (uint64_t)1 << (in_index % 64);
+      if ((m_leaves[leaf].fetch_or(bit, std::memory_order_release) & bit) != 0)
+        return;   // already marked (the summary bit is set as well)
+      m_summaries[leaf / 64].fetch_or((uint64_t)1 << (leaf % 64),
+                                      std::memory_order_release);
     }
     // -------------------------------------------------------------------------
-    // on_activate
+    // take
     // -------------------------------------------------------------------------
-    void on_activate() override
+    // Calls in_func(index) for every marked index (in ascending order) and
+    // clears them. Returns the number of indices
+    //
+    template <class F>
+    size_t take(F &&in_func)
     {
-      // The application has been started, so let's show a window.
-      process_create_windows();
+      size_t count = 0;
+      for (size_t s = 0; s < m_summary_num; s++)
+      {
+        if (m_summaries[s].load(std::memory_order_relaxed) == 0)
+          continue;
+        uint64_t summary = m_summaries[s].exchange(0, std::memory_order_acquire);
+        while (summary != 0)
+        {
+          size_t leaf = s * 64 + count_trailing_zeros(summary);
+          summary &= summary - 1;
+          uint64_t bits = m_leaves[leaf].exchange(0, std::memory_order_acquire);
+          while (bits != 0)
+          {
+            in_func(leaf * 64 + count_trailing_zeros(bits));
+            bits &= bits - 1;
+            count++;
+          }
+        }
+      }
+      return count;
     }
+
+  protected:
+    // static functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // on_delete_event
+    // grow
     // -------------------------------------------------------------------------
-    bool on_delete_event(GdkEventAny *in_event)
+    static std::atomic<uint64_t> *grow(std::atomic<uint64_t> *in_words,
+                                       size_t in_num, size_t in_new_num)
     {
-      for (auto it = m_window_list.begin(); it != m_window_list.end(); it++)
-      {
-        //if (in_window == (*it)->back_app_get_window())
-        if (in_event->window == (*it)->back_app_get_window()->get_window()->gobj())
-          return (*it)->back_app_delete_request();
-      }
-      return false;
+      auto *words = new std::atomic<uint64_t>[in_new_num];
+      for (size_t i = 0; i < in_new_num; i++)
+        words[i].store(i < in_num ? in_words[i].load() : 0);
+      delete[] in_words;
+      return words;
     }
     // -------------------------------------------------------------------------
-    // on_hide_window
+    // count_trailing_zeros
     // -------------------------------------------------------------------------
-    void on_hide_window(Gtk::Window *in_window)
+    static size_t count_trailing_zeros(uint64_t in_bits)
     {
-      for (auto it = m_window_list.begin(); it != m_window_list.end(); it++)
+#if defined(__GNUC__) || defined(__clang__)
+      return (size_t)__builtin_ctzll(in_bits);
+#else
+      size_t n = 0;
+      while ((in_bits & 1) == 0)
       {
-        if (in_window == (*it)->back_app_get_window())
-        {
-          (*it)->back_app_delete_window();
-          m_window_list.erase(it);
-          break;
-        }
+        in_bits >>= 1;
+        n++;
       }
-      if (m_window_list.empty())
-        m_window_cond.notify_all();
+      return n;
+#endif
     }
+
+  private:
+    // member variables --------------------------------------------------------
+    size_t m_size;
+    size_t m_leaf_num, m_summary_num;
+    std::atomic<uint64_t> *m_leaves;
+    std::atomic<uint64_t> *m_summaries;
+  };
+
+  // ===========================================================================
+  //  TripleBuffer class
+  // ===========================================================================
+  // Single-producer / single-consumer value publication. The producer fills
+  // get_back() and calls publish(); the consumer calls acquire() and gets the
+  // latest published value. Each side is one atomic exchange, no lock.
+  // [Note] the value returned by acquire() stays valid (and unchanged) until
+  // the next acquire() call
+  //
+  template <class T>
+  class TripleBuffer
+  {
+  public:
     // -------------------------------------------------------------------------
-    // on_idle
+    // TripleBuffer constructor
     // -------------------------------------------------------------------------
-    bool on_idle()
+    TripleBuffer() :
+        m_middle(1), m_front(0), m_back(2)
     {
-      SHL_DBG_OUT("on_idle() was called");
-      process_create_windows();
-      process_update_windows();
-      process_delete_windows();
-      process_connect_timers();
-      process_disconnect_timers();
-      if (m_quit)
-        quit();
-      // by returning false here, this signal handler will be disconnected
-      // from Glib::signal_idle()
-      // https://gnome.pages.gitlab.gnome.org/gtkmm-documentation/sec-idle-functions.html
-      return false;
     }
     // -------------------------------------------------------------------------
-    // process_create_windows
+    // TripleBuffer destructor
     // -------------------------------------------------------------------------
-    void process_create_windows()
-    {
-      std::lock_guard<std::mutex> lock(m_create_win_queue_mutex);
-      while (!m_create_win_queue.empty())
-      {
-        BackgroundAppWindowInterface *interface = m_create_win_queue.front();
-        const char *title = m_win_title_queue.front();
-        auto it = std::find(m_window_list.begin(), m_window_list.end(), interface);
-        if (it == m_window_list.end())
-        {
-          Gtk::Window *win = interface->back_app_create_window(title);
-          add_window(*win);
-          win->signal_delete_event().connect(sigc::mem_fun(*this,
-                            &BackgroundApp::on_delete_event));
-          win->signal_hide().connect(sigc::bind<Gtk::Window *>(
-                  sigc::mem_fun(*this,
-                                &BackgroundApp::on_hide_window), win));
-          win->present();
-          m_window_list.push_back(interface);
-        }
-        m_create_win_queue.pop();
-        m_win_title_queue.pop();
-      }
-    }
+    virtual ~TripleBuffer() = default;
+
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // process_delete_windows
+    // get_back (producer)
     // -------------------------------------------------------------------------
-    void process_delete_windows()
+    T *get_back()
     {
-      std::lock_guard<std::mutex> lock(m_delete_win_queue_mutex);
-      while (!m_delete_win_queue.empty())
-      {
-        BackgroundAppWindowInterface *interface = m_delete_win_queue.front();
-        auto it = std::find(m_window_list.begin(), m_window_list.end(), interface);
-        if (it != m_window_list.end())
-        {
-          Gtk::Window *win = interface->back_app_get_window();
-          win->close();
-          remove_window(*win);
-          interface->back_app_delete_window();
-          m_window_list.erase(it);
-        }
-        m_delete_win_queue.pop();
-      }
+      return &m_buffers[m_back];
     }
     // -------------------------------------------------------------------------
-    // process_update_windows
+    // publish (producer)
     // -------------------------------------------------------------------------
-    void process_update_windows()
+    void publish()
     {
-      std::lock_guard<std::mutex> lock(m_update_win_queue_mutex);
-      while (!m_update_win_queue.empty())
-      {
-        BackgroundAppWindowInterface *interface = m_update_win_queue.front();
-        auto it = std::find(m_window_list.begin(), m_window_list.end(), interface);
-        if (it != m_window_list.end())
-          interface->back_app_update_window();
-        m_update_win_queue.pop();
-      }
+      m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
     }
     // -------------------------------------------------------------------------
-    // process_connect_timers
+    // acquire (consumer)
     // -------------------------------------------------------------------------
-    void process_connect_timers()
+    const T *acquire()
     {
-      std::lock_guard<std::mutex> lock(m_connect_timer_queue_mutex);
-      while (!m_connect_timer_queue.empty())
-      {
-        TimerData *timer = m_connect_timer_queue.front();
-        timer->connect();
-        m_connect_timer_queue.pop();
-      }
+      if ((m_middle.load(std::memory_order_relaxed) & FRESH) != 0)
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+      return &m_buffers[m_front];
     }
     // -------------------------------------------------------------------------
-    // process_disconnect_timers
+    // fill
     // -------------------------------------------------------------------------
-    void process_disconnect_timers()
+    // [Note] only before the producer and the consumer are running
+    //
+    void fill(const T &in_value)
     {
-      std::lock_guard<std::mutex> lock(m_disconnect_timer_queue_mutex);
-      while (!m_disconnect_timer_queue.empty())
-      {
-        TimerData *timer = m_disconnect_timer_queue.front();
-        timer->disconnect();
-        m_disconnect_timer_queue.pop();
-      }
+      for (auto &buffer : m_buffers)
+        buffer = in_value;
     }
 
   private:
-    // member variables --------------------------------------------------------
-    std::mutex m_create_win_queue_mutex;
-    std::queue<BackgroundAppWindowInterface *> m_create_win_queue;
-    std::queue<const char *> m_win_title_queue;
-    std::mutex m_delete_win_queue_mutex;
-    std::queue<BackgroundAppWindowInterface *> m_delete_win_queue;
-    std::mutex m_update_win_queue_mutex;
-    std::queue<BackgroundAppWindowInterface *> m_update_win_queue;
-    //
-    std::mutex m_connect_timer_queue_mutex;
-    std::queue<TimerData *> m_connect_timer_queue;
-    std::mutex m_disconnect_timer_queue_mutex;
-    std::queue<TimerData *> m_disconnect_timer_queue;
-    //
-    std::vector<BackgroundAppWindowInterface *> m_window_list;
-    std::condition_variable m_window_cond;
-    std::mutex  m_window_mutex;
-    bool m_quit;
+    // constants ---------------------------------------------------------------
+    static const unsigned INDEX_MASK = 0x3;
+    static const unsigned FRESH = 0x4;
 
-    // friend classes ----------------------------------------------------------
-    friend class BackgroundAppRunner;
+    // member variables --------------------------------------------------------
+    T m_buffers[3];
+    std::atomic<unsigned> m_middle;  // index | FRESH
+    unsigned  m_front;   // owned by the consumer
+    unsigned  m_back;    // owned by the producer
   };
 
   // ===========================================================================
-  //  BackgroundAppRunner class
+  //  LatestValueSlot class
   // ===========================================================================
-  class BackgroundAppRunner
+  // Single pending value that the producer overwrites (the latest value
+  // wins). store() returns true only when the slot changed from empty to
+  // pending, so the producer queues one update for any number of stores,
+  // and the consumer applies the newest value with take().
+  // Nothing is locked: the value is handed over through a TripleBuffer
+  // (std::atomic<T> for trivially copyable types, see below).
+  // [Note] one producer thread and one consumer thread per slot
+  //
+  template <class T, bool TRIVIAL = std::is_trivially_copyable<T>::value>
+  class LatestValueSlot
   {
   public:
     // -------------------------------------------------------------------------
-    // BackgroundAppRunner destructor
+    // LatestValueSlot constructor
     // -------------------------------------------------------------------------
-    virtual ~BackgroundAppRunner()
+    LatestValueSlot() :
+        m_pending(false)
     {
-      if (m_app != nullptr)
-        m_app->post_quit_app();
-      if (m_thread != nullptr)
-      {
-        m_thread->join();
-        delete m_thread;
-        delete m_app;
-      }
-      SHL_DBG_OUT("BackgroundAppRunner was deleted");
     }
-
-  protected:
     // -------------------------------------------------------------------------
-    // BackgroundAppRunner constructor
+    // LatestValueSlot destructor
     // -------------------------------------------------------------------------
-    BackgroundAppRunner() :
-      m_app(nullptr), m_thread(nullptr)
-    {
-    }
+    virtual ~LatestValueSlot() = default;
 
     // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // wait_window_all_closed
-    // -------------------------------------------------------------------------
-    void wait_window_all_closed()
-    {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-        return;
-      m_app->wait_window_all_closed();
-    }
-    // -------------------------------------------------------------------------
-    // get_window_num
+    // store (producer)
     // -------------------------------------------------------------------------
-    size_t get_window_num()
+    template <class U>
+    bool store(U &&in_value)
     {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-        return 0;
-      return m_app->get_window_num();
+      *m_buffer.get_back() = std::forward<U>(in_value);
+      m_buffer.publish();
+      return m_pending.exchange(true, std::memory_order_acq_rel) == false;
     }
     // -------------------------------------------------------------------------
-    // is_window_close_all
+    // take (consumer)
     // -------------------------------------------------------------------------
-    bool is_window_close_all()
+    // [Note] the pending flag is cleared before the value is read, so a store
+    // racing with take() queues another update (never a lost value). The
+    // exchange reads the flag of the last store, so its publish() is visible
+    //
+    void take(T *out_value)
     {
-      if (get_window_num() == 0)
-        return true;
-      return false;
+      m_pending.exchange(false, std::memory_order_acq_rel);
+      *out_value = *m_buffer.acquire();
     }
     // -------------------------------------------------------------------------
-    // create_window
+    // is_pending
     // -------------------------------------------------------------------------
-    void create_window(BackgroundAppWindowInterface *in_interface, const char *in_title)
+    bool is_pending() const
     {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-      {
-        m_app = new BackgroundApp();
-        m_app->hold();
-      }
-      m_app->post_create_window(in_interface, in_title);
-      if (m_thread != nullptr)
-        return;
-      m_thread = new std::thread(thread_func, this);
+      return m_pending.load(std::memory_order_acquire);
     }
+
+  private:
+    // member variables --------------------------------------------------------
+    TripleBuffer<T> m_buffer;
+    std::atomic<bool> m_pending;
+  };
+
+  // ===========================================================================
+  //  LatestValueSlot class (trivially copyable T)
+  // ===========================================================================
+  // [Note] the value itself is atomic, so any number of producers is fine
+  //
+  template <class T>
+  class LatestValueSlot<T, true>
+  {
+  public:
     // -------------------------------------------------------------------------
-    // delete_window
+    // LatestValueSlot constructor
     // -------------------------------------------------------------------------
-    void delete_window(BackgroundAppWindowInterface *in_interface)
+    LatestValueSlot() :
+        m_value(T()), m_pending(false)
     {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-        return;
-      m_app->post_delete_window(in_interface);
     }
     // -------------------------------------------------------------------------
-    // update_window
+    // LatestValueSlot destructor
     // -------------------------------------------------------------------------
-    void update_window(BackgroundAppWindowInterface *in_interface)
-    {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-        return;
-      m_app->post_update_window(in_interface);
-    }
+    virtual ~LatestValueSlot() = default;
+
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // connect_timer
+    // store
     // -------------------------------------------------------------------------
-    void connect_timer(TimerData *inTimerData)
+    bool store(T in_value)
     {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-        return;
-      m_app->post_connect_timer(inTimerData);
+      m_value.store(in_value, std::memory_order_release);
+      return m_pending.exchange(true, std::memory_order_acq_rel) == false;
     }
     // -------------------------------------------------------------------------
-    // disconnect_timer
+    // take
     // -------------------------------------------------------------------------
-    void disconnect_timer(TimerData *inTimerData)
+    void take(T *out_value)
     {
-      std::lock_guard<std::mutex> lock(m_function_call_mutex);
-      if (m_app == nullptr)
-        return;
-      m_app->post_disconnect_timer(inTimerData);
+      m_pending.exchange(false, std::memory_order_acq_rel);
+      *out_value = m_value.load(std::memory_order_acquire);
     }
-
-    // static functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // get_runner
+    // is_pending
     // -------------------------------------------------------------------------
-    static BackgroundAppRunner *get_runner()
+    bool is_pending() const
     {
-      static BackgroundAppRunner s_runner;
-      return &s_runner;
+      return m_pending.load(std::memory_order_acquire);
     }
 
   private:
     // member variables --------------------------------------------------------
-    BackgroundApp *m_app;
-    std::thread *m_thread;
-    std::mutex m_function_call_mutex;
-
-    // static functions --------------------------------------------------------
-    // -------------------------------------------------------------------------
-    // thread_func
-    // -------------------------------------------------------------------------
-    static void thread_func(BackgroundAppRunner *in_obj)
-    {
-      SHL_TRACE_OUT("thread started");
-      in_obj->m_app->run();
-      SHL_TRACE_OUT("thread ended");
-    }
-
-    // friend classes ----------------------------------------------------------
-    friend class WindowBase;
+    std::atomic<T> m_value;
+    std::atomic<bool> m_pending;
   };
 
   // ===========================================================================
-  //  WindowBase class
+  //  SampleRing class
   // ===========================================================================
-  class WindowBase : private BackgroundAppWindowInterface
+  // Single-producer history ring of float samples. push() never blocks and
+  // never fails: the oldest samples are overwritten. read_latest() copies
+  // the newest samples and drops the ones the producer overwrote meanwhile.
+  // [Note] one producer thread per ring, any number of readers
+  //
+  class SampleRing
   {
   public:
     // -------------------------------------------------------------------------
-    // WindowBase destructor
+    // SampleRing constructor
     // -------------------------------------------------------------------------
-    virtual ~WindowBase()
+    explicit SampleRing(size_t in_capacity) :
+        m_head(0)
     {
-      kill_timer(nullptr);  // stop and delete all timers (just in case)
-      m_app_runner->delete_window(this);
+      size_t capacity = 2;
+      while (capacity < in_capacity)
+        capacity <<= 1;
+      m_mask = capacity - 1;
+      m_samples = new std::atomic<float>[capacity];
+      for (size_t i = 0; i < capacity; i++)
+        m_samples[i].store(0.0f, std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    // SampleRing destructor
+    // -------------------------------------------------------------------------
+    virtual ~SampleRing()
+    {
+      delete[] m_samples;
     }
 
     // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // wait_window_closed
+    // push
     // -------------------------------------------------------------------------
-    /**
-     * Waits until the window associated to the object is closed.
-     * @note This is a blocking function.
-     *
-     */
-    void wait_window_closed()
+    void push(float in_sample)
     {
-      back_app_wait_delete_window();
+      uint64_t head = m_head.load(std::memory_order_relaxed);
+      // (pairs with the acquire fence in read_latest())
+      std::atomic_thread_fence(std::memory_order_release);
+      m_samples[head & m_mask].store(in_sample, std::memory_order_relaxed);
+      m_head.store(head + 1, std::memory_order_release);
     }
     // -------------------------------------------------------------------------
-    // is_window_closed
+    // push
     // -------------------------------------------------------------------------
-    /**
-     * Checks whether the opened window is closed or not.
-     * @ The window associated to this object
-     *
-     * @return Whether the window is closed or not
-     *  - true : The window was closed
-     *  - false : The window is not closed
-     */
-    bool is_window_closed()
+    void push(const float *in_samples, size_t in_num)
     {
-      return back_app_is_window_deleted();
+      uint64_t head = m_head.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (size_t i = 0; i < in_num; i++)
+        m_samples[(head + i) & m_mask].store(in_samples[i], std::memory_order_relaxed);
+      m_head.store(head + in_num, std::memory_order_release);
     }
     // -------------------------------------------------------------------------
-    // wait_window_close_all
+    // get_capacity
     // -------------------------------------------------------------------------
-    /**
-     * Waits until all of the windows are closed.
-     * @note The windows including opened by the other objects
-     */
-    void wait_window_close_all()
+    size_t get_capacity() const
     {
-      m_app_runner->wait_window_all_closed();
+      return m_mask + 1;
     }
     // -------------------------------------------------------------------------
-    // is_window_close_all
+    // get_head
     // -------------------------------------------------------------------------
-    /**
-     * Checks whether the all windows are closed or not.
-     * @note The windows including opened by the other objects
-     *
-     * @return Whether the window is closed or not
-     *  - true : The windows were all closed
-     *  - false : The all of the windows are still not closed
-     */
-    bool is_window_close_all()
-    {
-      return m_app_runner->is_window_close_all();
-    }
-    // -------------------------------------------------------------------------
-    // get_window_num
-    // -------------------------------------------------------------------------
-    /**
-     * Retrieves the number of opened windows.
-     * @note The windows including opened by the other objects
-     *
-     * @return the number of opened windows
-     */
-    size_t get_window_num()
-    {
-      return m_app_runner->get_window_num();
-    }
-    // -------------------------------------------------------------------------
-    // show_window
-    // -------------------------------------------------------------------------
-    /**
-     * Shows a window.
-     * @note if in_title is nullptr, the title will be automatically generated.
-     *
-     * @param in_title  The title of the window
-     */
-    void show_window(const char *in_title = nullptr)
+    // [Note] total number of pushed samples
+    //
+    uint64_t get_head() const
     {
-      if (back_app_get_window() != nullptr)
-        return;
-      m_app_runner->create_window(this, in_title);
-      back_app_wait_new_window();
-      start_all_timers();
+      return m_head.load(std::memory_order_acquire);
     }
     // -------------------------------------------------------------------------
-    // update
+    // read_latest
     // -------------------------------------------------------------------------
-    /**
-     * Tells the library to updates the window.
-     * @note This function needs to be called when the content of the object is
-     * updated
-     */
-    void update()
-    {
-      if (back_app_get_window() == nullptr)
-        return;
-      m_app_runner->update_window(this);
+    // Copies up to in_num newest samples (oldest first) to out_samples and
+    // returns the number of copied samples
+    //
+    size_t read_latest(float *out_samples, size_t in_num) const
+    {
+      uint64_t head = m_head.load(std::memory_order_acquire);
+      size_t num = (size_t)std::min<uint64_t>(std::min<uint64_t>(in_num, head),
+                                              get_capacity());
+      uint64_t first = head - num;
+      for (size_t i = 0; i < num; i++)
+        out_samples[i] = m_samples[(first + i) & m_mask].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      // [Note] the slot of sample new_head - capacity may be being rewritten
+      // (sample new_head), so the samples before new_head - capacity + 1 are
+      // considered lost
+      uint64_t new_head = m_head.load(std::memory_order_relaxed);
+      if (new_head - first < get_capacity())
+        return num;
+      // the oldest part was overwritten while copying
+      size_t lost = (size_t)std::min<uint64_t>(new_head - first - get_capacity() + 1, num);
+      std::memmove(out_samples, out_samples + lost, (num - lost) * sizeof(float));
+      return num - lost;
     }
+    // static functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // get_user_event_queue()
+    // find_min_max
     // -------------------------------------------------------------------------
-    EventQueue *get_user_event_queue()
-    {
-      if (m_user_event_queue != nullptr)
-        return m_user_event_queue;
-      return get_user_global_queue();
+    // [Note] in_num must be > 0
+    //
+    static void find_min_max(const float *in_samples, size_t in_num,
+                             float *out_min, float *out_max)
+    {
+      size_t i = 0;
+      float min_value = in_samples[0];
+      float max_value = in_samples[0];
+#ifdef SHL_GTK_SSE2
+      if (in_num >= 8)
+      {
+        __m128 min4 = _mm_loadu_ps(in_samples);
+        __m128 max4 = min4;
+        for (i = 4; i + 4 <= in_num; i += 4)
+        {
+          __m128 v = _mm_loadu_ps(in_samples + i);
+          min4 = _mm_min_ps(min4, v);
+          max4 = _mm_max_ps(max4, v);
+        }
+        min4 = _mm_min_ps(min4, _mm_shuffle_ps(min4, min4, _MM_SHUFFLE(1, 0, 3, 2)));
+        min4 = _mm_min_ps(min4, _mm_shuffle_ps(min4, min4, _MM_SHUFFLE(2, 3, 0, 1)));
+        max4 = _mm_max_ps(max4, _mm_shuffle_ps(max4, max4, _MM_SHUFFLE(1, 0, 3, 2)));
+        max4 = _mm_max_ps(max4, _mm_shuffle_ps(max4, max4, _MM_SHUFFLE(2, 3, 0, 1)));
+        min_value = _mm_cvtss_f32(min4);
+        max_value = _mm_cvtss_f32(max4);
+      }
+#endif
+      for (; i < in_num; i++)
+      {
+        min_value = std::min(min_value, in_samples[i]);
+        max_value = std::max(max_value, in_samples[i]);
+      }
+      *out_min = min_value;
+      *out_max = max_value;
     }
     // -------------------------------------------------------------------------
-    // push_update_event()
+    // decimate_min_max
     // -------------------------------------------------------------------------
-    void push_update_event(void *inSource, void (*in_func)(EventData *))
+    // Reduces in_num samples to in_column_num (min, max) pairs
+    // [Note] in_num must be >= in_column_num
+    //
+    static void decimate_min_max(const float *in_samples, size_t in_num,
+                                 size_t in_column_num,
+                                 float *out_min, float *out_max)
     {
-      m_background_queue.push(inSource, in_func);
+      for (size_t c = 0; c < in_column_num; c++)
+      {
+        size_t start = c * in_num / in_column_num;
+        size_t end = (c + 1) * in_num / in_column_num;
+        find_min_max(in_samples + start, end - start, &out_min[c], &out_max[c]);
+      }
     }
+
+  private:
+    // member variables --------------------------------------------------------
+    std::atomic<float> *m_samples;
+    size_t  m_mask;
+    std::atomic<uint64_t> m_head;
+  };
+
+  // ===========================================================================
+  //  LabelIndex class
+  // ===========================================================================
+  // Case-insensitive (ASCII) substring search over a list of labels. Every
+  // trigram of the labels has a sorted posting list, so a query of three or
+  // more characters only verifies the labels in its rarest trigram list.
+  // Shorter queries scan the (lower case) labels.
+  //
+  class LabelIndex
+  {
+  public:
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // push_update_event()
+    // clear
     // -------------------------------------------------------------------------
-    void push_update_event(EventData *in_update)
+    void clear()
     {
-      m_background_queue.push(in_update);
+      m_labels.clear();
+      m_postings.clear();
     }
     // -------------------------------------------------------------------------
-    // add_close_event_listener
+    // add
     // -------------------------------------------------------------------------
-    void add_close_event_listener(base::EventQueue *in_event_queue)
+    // [Note] the labels are numbered in the order they are added
+    //
+    void add(std::string_view in_label)
     {
-      m_close_notify_list.push_back(in_event_queue);
+      uint32_t index = (uint32_t)m_labels.size();
+      m_labels.emplace_back(in_label);
+      std::string &label = m_labels.back();
+      to_lower(&label);
+      for (size_t i = 0; i + 3 <= label.size(); i++)
+      {
+        std::vector<uint32_t> &posting = m_postings[trigram(&label[i])];
+        if (posting.empty() || posting.back() != index)
+          posting.push_back(index);
+      }
     }
     // -------------------------------------------------------------------------
-    // connect_timer
+    // size
     // -------------------------------------------------------------------------
-    TimerData *add_timer(
-                  unsigned int in_interval_ms,
-                  void (*in_timer_event_func)(void *in_user_data) = nullptr,
-                  void *in_user_data = nullptr,
-                  base::EventQueue *in_user_event_queue = nullptr)
+    size_t size() const
     {
-      if (in_user_event_queue == nullptr)
-        in_user_event_queue = get_user_event_queue();
-      TimerData *timer;
-      timer = new TimerData(
-              in_interval_ms,
-              in_user_event_queue,
-              in_timer_event_func,
-              in_user_data);
-      m_timer_list.push_back(timer);
-      return timer;
+      return m_labels.size();
     }
     // -------------------------------------------------------------------------
-    // kill_timer
+    // find
     // -------------------------------------------------------------------------
-    // [note]
-    // after calling this function, passed inTimeData will be no
-    // longer valid (the linked object will be deleted internally)
-    // specifying nullptr will remove all timers associated with this window
+    // Stores 1 to (*out_match)[i] if the label i contains in_query (0 if not)
+    // and returns the number of the matched labels
     //
-    void kill_timer(TimerData *inTimerData = nullptr)
-    {
-      if (inTimerData == nullptr)
-        return;
-      
-      for (auto it = m_timer_list.begin(); it != m_timer_list.end(); it++)
-        if ((*it) == inTimerData || inTimerData == nullptr)
-        {
-          m_app_runner->disconnect_timer((*it));
-          delete (*it);
-          if (inTimerData != nullptr)
+    size_t find(std::string_view in_query, std::vector<char> *out_match) const
+    {
+      std::string query(in_query);
+      to_lower(&query);
+      out_match->assign(m_labels.size(), query.empty() ? 1 : 0);
+      if (query.empty())
+        return m_labels.size();
+      size_t num = 0;
+      if (query.size() < 3)
+      {
+        for (size_t i = 0; i < m_labels.size(); i++)
+          if (m_labels[i].find(query) != std::string::npos)
           {
-            m_timer_list.erase(it);
-            break;
+            (*out_match)[i] = 1;
+            num++;
           }
+        return num;
+      }
+      // the rarest trigram of the query gives the candidates
+      const std::vector<uint32_t> *candidates = nullptr;
+      for (size_t i = 0; i + 3 <= query.size(); i++)
+      {
+        auto it = m_postings.find(trigram(&query[i]));
+        if (it == m_postings.end())
+          return 0;
+        if (candidates == nullptr || it->second.size() < candidates->size())
+          candidates = &it->second;
+      }
+      for (auto it = candidates->begin(); it != candidates->end(); it++)
+        if (m_labels[*it].find(query) != std::string::npos)
+        {
+          (*out_match)[*it] = 1;
+          num++;
         }
-      if (inTimerData == nullptr)
-        m_timer_list.clear();
+      return num;
     }
 
   protected:
-    // Virtual Member functions --------------------------------------------------------
-    virtual Gtk::Window *create_window_object(const char *in_title) = 0;
-    virtual Gtk::Window *get_window_object() = 0;
-    virtual void delete_window_object() = 0;
-    virtual bool is_window_object_null() = 0;
-    virtual void update_window() = 0;
-    virtual const char *get_default_window_title() = 0;
-
-    // -------------------------------------------------------------------------
-    // WindowBase constructor
-    // -------------------------------------------------------------------------
-    WindowBase(EventQueue *in_user_event_queue = nullptr) :
-      m_user_event_queue(in_user_event_queue)
-    {
-      m_app_runner = BackgroundAppRunner::get_runner();
-    }
-    // Member functions --------------------------------------------------------
+    // static functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // process_update_events()
+    // trigram
     // -------------------------------------------------------------------------
-    void process_update_events(bool in_last_only = false)
+    static uint32_t trigram(const char *in_chars)
     {
-      m_background_queue.process_events(in_last_only);
+      return (uint32_t)(unsigned char)in_chars[0] |
+             ((uint32_t)(unsigned char)in_chars[1] << 8) |
+             ((uint32_t)(unsigned char)in_chars[2] << 16);
     }
     // -------------------------------------------------------------------------
-    // start_all_timers
+    // to_lower
     // -------------------------------------------------------------------------
-    void start_all_timers()
+    static void to_lower(std::string *io_text)
     {
-      for (auto it = m_timer_list.begin(); it != m_timer_list.end(); it++)
-        m_app_runner->connect_timer((*it));
+      for (auto it = io_text->begin(); it != io_text->end(); it++)
+        if (*it >= 'A' && *it <= 'Z')
+          *it = (char)(*it - 'A' + 'a');
     }
 
   private:
     // member variables --------------------------------------------------------
-    BackgroundAppRunner *m_app_runner;
-    EventQueue  m_background_queue;
-    EventQueue  *m_user_event_queue;
-    std::condition_variable m_new_window_cond;
-    std::mutex  m_new_window_mutex;
-    std::condition_variable m_delete_window_cond;
-    std::mutex  m_delete_window_mutex;
-    std::vector<base::EventQueue *> m_close_notify_list;
-    std::vector<TimerData *>   m_timer_list;
+    std::vector<std::string> m_labels;   // (lower case)
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;
+  };
 
-    // BackgroundAppWindowInterface functions ----------------------------------
+  // ===========================================================================
+  //  Event priority / lane definitions
+  // ===========================================================================
+  enum EventPriority
+  {
+    EVENT_PRIORITY_HIGH = 0,  // timers, button presses (latency-sensitive)
+    EVENT_PRIORITY_NORMAL,
+    EVENT_PRIORITY_LOW,       // bulk traffic (e.g. entry text changes)
+    EVENT_PRIORITY_NUM
+  };
+  enum LaneMode
+  {
+    LANE_MODE_FIFO = 0, // single FIFO (the priority is ignored)
+    LANE_MODE_STRICT,   // always the highest priority lane first
+    LANE_MODE_WEIGHTED  // weighted round robin over the lanes
+  };
+  enum OverflowPolicy
+  {
+    OVERFLOW_DROP_OLDEST = 0, // discard the oldest pending event
+    OVERFLOW_DROP_NEWEST,     // discard the event being pushed
+    OVERFLOW_COALESCE_SOURCE, // replace a pending event of the same source
+    OVERFLOW_BLOCK            // push() waits until there is room
+  };
+
+  // ===========================================================================
+  //  EventData class
+  // ===========================================================================
+  class EventData
+  {
+  public:
     // -------------------------------------------------------------------------
-    // back_app_create_window (called from the UI thread)
+    // EventData destructor
     // -------------------------------------------------------------------------
-    Gtk::Window *back_app_create_window(const char *in_title) override
-    {
-      static int window_num = 0;
-      char buf[256];
-      if (in_title != nullptr)
-        if (*in_title == 0)
-          in_title = nullptr;
-      if (in_title == nullptr)
-      {
-        const char *title = get_default_window_title();
-        if (window_num == 0)
-          sprintf(buf, "%s", title);
-        else
-          sprintf(buf, "%s_%d", title, window_num);
-        in_title = buf;
-      }
-      Gtk::Window *window = create_window_object(in_title);
-      m_new_window_cond.notify_all();
-      window_num++;
-      return window;
-    }
+    virtual ~EventData() = default;
     // -------------------------------------------------------------------------
-    // back_app_wait_new_window (called from the UI thread)
+    // get_source
     // -------------------------------------------------------------------------
-    void back_app_wait_new_window() override
+    virtual void *get_source()
     {
-      std::unique_lock<std::mutex> lock(m_new_window_mutex);
-      m_new_window_cond.wait(lock);
+      return m_source;
     }
+
+    // operators ---------------------------------------------------------------
     // -------------------------------------------------------------------------
-    // back_app_delete_request (called from the UI thread)
+    // operator new / delete
     // -------------------------------------------------------------------------
-    Gtk::Window *back_app_get_window() override
+    // [Note] "new (pool) SomeEvent(...)" takes the block from the pool.
+    // "delete event" always returns the block to its owner pool
+    //
+    static void *operator new(size_t in_size)
     {
-      return get_window_object();
+      return EventPool::alloc_block(nullptr, in_size);
     }
-    // -------------------------------------------------------------------------
-    // back_app_delete_request (called from the UI thread)
-    // -------------------------------------------------------------------------
-    bool back_app_delete_request() override
+    static void *operator new(size_t in_size, EventPool *in_pool)
     {
-      return false; // by returning true, we can cancel window close
+      return EventPool::alloc_block(in_pool, in_size);
     }
-    // -------------------------------------------------------------------------
-    // back_app_delete_window (called from the UI thread)
-    // -------------------------------------------------------------------------
-    void back_app_delete_window() override
+    static void operator delete(void *in_ptr)
     {
-      // we need to disconnect all timers first
-      for (auto it = m_timer_list.begin(); it != m_timer_list.end(); it++)
-        (*it)->disconnect();
-      delete_window_object();
-      m_delete_window_cond.notify_all();
-      // We need to notify all event queues to un-block event queue's wait()
-      for (auto it = m_close_notify_list.begin(); it != m_close_notify_list.end(); it++)
-        (*it)->notify();
+      EventPool::free_block(in_ptr);
     }
-    // -------------------------------------------------------------------------
-    // back_app_is_window_deleted (called from the UI thread)
-    // -------------------------------------------------------------------------
-    bool back_app_is_window_deleted() override
+    static void operator delete(void *in_ptr, EventPool *)
     {
-      return is_window_object_null();
+      EventPool::free_block(in_ptr);
     }
+
+  protected:
     // -------------------------------------------------------------------------
-    // back_app_wait_delete_window (called from the UI thread)
+    // EventData constructor
     // -------------------------------------------------------------------------
-    void back_app_wait_delete_window() override
+    EventData(void *in_source, void (*in_handler)(EventData *)) :
+        m_source(in_source),
+        m_handler(in_handler)
     {
-      std::unique_lock<std::mutex> lock(m_delete_window_mutex);
-      m_delete_window_cond.wait(lock);
     }
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // back_app_update_window
+    // is_same_source
     // -------------------------------------------------------------------------
-    void back_app_update_window() override
+    virtual bool is_same_source(EventData *in_event_data)
     {
-      update_window();
-    }
-    // static functions --------------------------------------------------------
+      if (m_source == in_event_data->m_source &&
+          m_handler       == in_event_data->m_handler)
+        return true;
+      return false;
+    }
     // -------------------------------------------------------------------------
-    // get_user_global_queue
+    // invoke_handler
     // -------------------------------------------------------------------------
-    static EventQueue *get_user_global_queue()
+    virtual void invoke_handler()
     {
-      static EventQueue s_user_global_queue;
-      return &s_user_global_queue;
+      if (m_handler != nullptr)
+        m_handler(this);
     }
+
+  private:
+    // member variables --------------------------------------------------------
+    void  *m_source;
+    void (*m_handler)(EventData *);
+
+    // friend classes ----------------------------------------------------------
+    friend class EventQueue;
+    friend class WindowBase;
   };
-} // namespace shl::gtk::base
-#else
-  // If another shl file is already included, we need to is_valid the base gtk class version
-  #if SHL_BASE_GTK_CLASS_VERSION != SHL_CONTROLS_WINDOW_GTK_BASE_VERSION
-    #error invalid shl base class version (There is a version inconsistency between included shl files)
-  #endif
+
+  // ===========================================================================
+  //  EventRecord struct
+  // ===========================================================================
+  // Compact tagged event that EventQueue stores by value (in the list nodes,
+  // the ring slots and the batches). Small events carry their payload inline
+  // and are dispatched by a switch on m_opcode, without a heap object or a
+  // virtual call. Larger events (e.g. the *Update classes) are boxed EventData.
+  // [Note] sizeof(EventRecord) is 56, so a ring slot (with its sequence
+  // counter) is 64 bytes
   //
-#endif  // SHL_BASE_GTK_CLASS_
+  enum EventOpcode
+  {
+    EVENT_OPCODE_NONE = 0,  // empty (already dispatched or coalesced)
+    EVENT_OPCODE_BOXED,     // m_payload.m_boxed->invoke_handler()
+    EVENT_OPCODE_CALL,      // handler(EventData *) that only needs the source
+    EVENT_OPCODE_VALUE      // handler(const EventRecord &) with m_payload
+  };
+  union EventValue
+  {
+    double    m_double;
+    int64_t   m_int;
+    bool      m_bool;
+    void      *m_ptr;
+    EventData *m_boxed;
+    unsigned char m_bytes[24];
+  };
+  struct EventRecord
+  {
+    void    *m_source;
+    void   (*m_handler)();    // the handler (the type depends on m_opcode)
+    int64_t m_enqueue_ns;     // only set while the queue statistics are enabled
+    unsigned char m_opcode;
+    unsigned char m_priority;
+    EventValue    m_payload;
+  };
+  static_assert(sizeof(EventRecord) <= 56, "EventRecord should fit in 56 bytes");
+  typedef void (*EventRecordHandler)(const EventRecord &);
+  typedef RingBuffer<EventRecord> EventRing;
 
-// The followings are for the friend class definition
-class ControlsWindow;
+#ifdef SHL_GTK_COROUTINE
+  // ===========================================================================
+  //  Executor class (interface)
+  // ===========================================================================
+  // Resumes the coroutines suspended on the awaitables of this header
+  // (e.g. EventQueueExecutor, or an adapter to an existing thread pool)
+  //
+  class Executor
+  {
+  public:
+    virtual ~Executor() = default;
+    virtual void post(std::coroutine_handle<> in_handle) = 0;
+  };
 
-// Namespace -------------------------------------------------------------------
-namespace controls     // shl::gtk::controls
-{
   // ===========================================================================
-  //  WidgetData class
+  //  AwaiterList class
   // ===========================================================================
-  class WidgetData
+  // [Note] the coroutines are resumed outside of the list lock, with the
+  // value passed to resume_all(). in_executor = nullptr resumes inline, i.e.
+  // on the thread that calls resume_all() (the producer, usually GTK)
+  //
+  template <typename T> class AwaiterList
   {
   public:
-    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // is_updated
+    // AwaiterList constructor
     // -------------------------------------------------------------------------
-    bool is_updated() const
+    AwaiterList() :
+        m_num(0)
     {
-      return m_is_updated;
     }
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // get_user_event_queue()
+    // add
     // -------------------------------------------------------------------------
-    base::EventQueue *get_user_event_queue()
+    void add(std::coroutine_handle<> in_handle, Executor *in_executor, T *out_result)
     {
-      if (m_user_event_queue != nullptr)
-        return m_user_event_queue;
-      return m_window->get_user_event_queue();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_list.push_back(Entry{in_handle, in_executor, out_result});
+      m_num.fetch_add(1, std::memory_order_seq_cst);
     }
-
-  protected:
     // -------------------------------------------------------------------------
-    // WidgetData constructor
+    // remove
     // -------------------------------------------------------------------------
-    WidgetData(base::WindowBase *in_window,
-            const char *in_label_str,
-            base::EventQueue *in_user_event_queue = nullptr) :
-        m_window(in_window),
-        m_label_str(in_label_str),
-        m_user_event_queue(in_user_event_queue),
-        m_horiz_box(nullptr), m_label(nullptr),
-        m_is_updated(false)
+    // [Note] returns false if the awaiter is already being resumed
+    //
+    bool remove(std::coroutine_handle<> in_handle)
     {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (auto it = m_list.begin(); it != m_list.end(); it++)
+      {
+        if ((*it).m_handle == in_handle)
+        {
+          m_list.erase(it);
+          m_num.fetch_sub(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+      return false;
     }
     // -------------------------------------------------------------------------
-    // WidgetData destructor
+    // has_awaiter
     // -------------------------------------------------------------------------
-    virtual ~WidgetData()
+    // [Note] pairs with the seq_cst increment in add() so that a producer
+    // either sees the new awaiter or the awaiter sees the new state
+    //
+    bool has_awaiter() const
     {
-      delete m_horiz_box;
-      delete m_label;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return m_num.load(std::memory_order_relaxed) != 0;
     }
-    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // create
+    // resume_all
     // -------------------------------------------------------------------------
-    virtual Gtk::Box *create()
+    void resume_all(const T &in_result)
     {
-      m_horiz_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_HORIZONTAL);
-      m_label = new Gtk::Label(m_label_str.c_str());
+      std::vector<Entry> list;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        list.swap(m_list);
+        m_num.store(0, std::memory_order_relaxed);
+      }
+      for (auto it = list.begin(); it != list.end(); it++)
+      {
+        *((*it).m_result) = in_result;
+        if ((*it).m_executor != nullptr)
+          (*it).m_executor->post((*it).m_handle);
+        else
+          (*it).m_handle.resume();
+      }
+    }
 
-      m_horiz_box->set_margin_left(8);
-      m_horiz_box->set_margin_right(8);
-      m_horiz_box->set_margin_top(2);
-      m_horiz_box->set_margin_bottom(2);
-      m_horiz_box->pack_start(*m_label, Gtk::PACK_SHRINK);
-      return m_horiz_box;
+  private:
+    struct Entry
+    {
+      std::coroutine_handle<> m_handle;
+      Executor  *m_executor;
+      T *m_result;
+    };
+    // member variables --------------------------------------------------------
+    std::vector<Entry>  m_list;
+    std::atomic<size_t> m_num;
+    std::mutex  m_mutex;
+  };
+
+  // ===========================================================================
+  //  ValueAwaiter class
+  // ===========================================================================
+  // Awaitable of "the next value" (e.g. co_await spin->changed())
+  //
+  template <typename T> class ValueAwaiter
+  {
+  public:
+    ValueAwaiter(AwaiterList<T> *in_list, Executor *in_executor) :
+        m_list(in_list), m_executor(in_executor), m_value()
+    {
+    }
+    bool await_ready() const
+    {
+      return false;
+    }
+    void await_suspend(std::coroutine_handle<> in_handle)
+    {
+      m_list->add(in_handle, m_executor, &m_value);
+    }
+    T await_resume()
+    {
+      return m_value;
     }
+
+  private:
+    AwaiterList<T>  *m_list;
+    Executor  *m_executor;
+    T m_value;
+  };
+#endif
+
+  // ===========================================================================
+  //  EventQueue class
+  // ===========================================================================
+  class EventQueue
+  {
+  public:
+    struct OverflowStats
+    {
+      size_t m_dropped_num;   // discarded by the drop-oldest / drop-newest policy
+      size_t m_coalesced_num; // replaced by a newer event of the same source
+      size_t m_blocked_num;   // push() calls that had to wait for room
+    };
+    // Enqueue-to-dispatch latency of one handler (log2 buckets)
+    struct LatencyHistogram
+    {
+      static const size_t BUCKET_NUM = 32;
+
+      void (*m_handler)();  // (cast of the handler function)
+      size_t    m_count;
+      uint64_t  m_total_ns;
+      uint64_t  m_max_ns;
+      size_t    m_buckets[BUCKET_NUM];  // [i] : 2^i <= ns < 2^(i+1) (the last one: more)
+
+      // -----------------------------------------------------------------------
+      // get_percentile_ns (the upper bound of the bucket, 0 if no sample)
+      // -----------------------------------------------------------------------
+      uint64_t get_percentile_ns(double in_ratio) const
+      {
+        if (m_count == 0)
+          return 0;
+        auto target = (size_t)(in_ratio * (double)m_count);
+        size_t sum = 0;
+        for (size_t i = 0; i < BUCKET_NUM - 1; i++)
+        {
+          sum += m_buckets[i];
+          if (sum > target)
+            return std::min<uint64_t>((uint64_t)1 << (i + 1), m_max_ns);
+        }
+        return m_max_ns;
+      }
+      // -----------------------------------------------------------------------
+      // get_mean_ns
+      // -----------------------------------------------------------------------
+      uint64_t get_mean_ns() const
+      {
+        if (m_count == 0)
+          return 0;
+        return m_total_ns / m_count;
+      }
+    };
+    struct Stats
+    {
+      size_t  m_depth;          // pending events now
+      size_t  m_peak_depth;     // since enabled / reset
+      size_t  m_enqueue_num;
+      size_t  m_dispatch_num;
+      double  m_enqueue_rate;   // events per second since enabled / reset
+      std::vector<LatencyHistogram> m_latency;  // one per handler
+    };
+
     // -------------------------------------------------------------------------
-    // mark_as_updated()
+    // EventQueue constructor
     // -------------------------------------------------------------------------
-    void mark_as_updated()
-    {
-      m_is_updated = true;
+    EventQueue() :
+        m_ring(nullptr),
+        m_overflow_num(0),
+        m_waiter_num(0),
+        m_carry_num(0),
+        m_list_num(0),
+        m_coalescing(false),
+        m_coalesced_num(0),
+        m_swap_drain(false),
+        m_event_fd(-1),
+        m_event_fd_signaled(false),
+        m_lane_mode(LANE_MODE_FIFO),
+        m_lane_cursor(EVENT_PRIORITY_NUM - 1),
+        m_lane_credit(0),
+        m_capacity(0),
+        m_overflow_policy(OVERFLOW_DROP_OLDEST),
+        m_space_waiter_num(0),
+        m_dropped_num(0),
+        m_overflow_coalesced_num(0),
+        m_blocked_num(0),
+        m_stats_enabled(false),
+        m_peak_depth(0),
+        m_enqueue_num(0),
+        m_dispatch_num(0),
+        m_stats_start_ns(0)
+    {
+      m_lane_weight[EVENT_PRIORITY_HIGH].store(8);
+      m_lane_weight[EVENT_PRIORITY_NORMAL].store(4);
+      m_lane_weight[EVENT_PRIORITY_LOW].store(1);
+#ifdef SHL_GTK_COROUTINE
+      m_deferred_num.store(0);
+#endif
     }
     // -------------------------------------------------------------------------
-    // push_event()
+    // EventQueue constructor
     // -------------------------------------------------------------------------
-    void push_event(void (*in_func)(base::EventData *))
+    // [Note] in_ring_capacity > 0 selects the lock-free ring buffer backend
+    //
+    explicit EventQueue(size_t in_ring_capacity) :
+        EventQueue()
     {
-      get_user_event_queue()->push(this, in_func);
+      if (in_ring_capacity != 0)
+        use_ring_buffer(in_ring_capacity);
     }
     // -------------------------------------------------------------------------
-    // push_event()
+    // EventQueue destructor
     // -------------------------------------------------------------------------
-    void push_event(base::EventData *in_event)
+    virtual ~EventQueue()
     {
-      get_user_event_queue()->push(in_event);
+      delete m_ring.load();
+      if (m_event_fd.load() >= 0)
+        close(m_event_fd.load());
     }
+    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // push_update()
-    // -------------------------------------------------------------------------
-    void push_update(void (*in_func)(base::EventData *))
+    // use_ring_buffer
+    // -------------------------------------------------------------------------
+    // Switches the queue to the bounded lock-free MPSC ring buffer backend.
+    // push() then never takes a lock unless the ring is full (the event spills
+    // into the locked list) or the consumer is sleeping in wait().
+    // [Note] the backend can not be switched back to the list. The events
+    // already pending in the list are kept: they are handled as spilled
+    // events, so they are dispatched first and the new events follow them
+    // through the list until the consumer has drained it.
+    // Returns false if the overflow policy is not supported by the ring (see
+    // set_capacity)
+    //
+    bool use_ring_buffer(size_t in_capacity)
     {
-      m_window->push_update_event(this, in_func);
+      if (in_capacity == 0)
+        return false;
+      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
+      if (m_ring.load() != nullptr)
+        return false;
+      if (is_ring_policy(m_capacity.load(std::memory_order_relaxed),
+                         m_overflow_policy.load(std::memory_order_relaxed)) == false)
+        return false;
+      m_overflow_num.store(m_list_num.load(std::memory_order_relaxed),
+                           std::memory_order_release);
+      m_ring.store(new EventRing(in_capacity));
+      return true;
     }
     // -------------------------------------------------------------------------
-    // push_update()
+    // is_ring_buffer
     // -------------------------------------------------------------------------
-    void push_update(base::EventData *in_update)
+    bool is_ring_buffer() const
     {
-      m_window->push_update_event(in_update);
+      return m_ring.load(std::memory_order_acquire) != nullptr;
     }
     // -------------------------------------------------------------------------
-    // invoke_update()
+    // set_coalescing
     // -------------------------------------------------------------------------
-    void invoke_update()
+    // In the coalescing mode, only the latest event for each (source, handler)
+    // pair is kept. With the list backend a new event replaces the pending
+    // one on push() (it is dispatched at the position of the latest push, as
+    // with process_events(true)), so draining costs the number of distinct
+    // sources. With the ring buffer backend the same result is computed in
+    // one pass at drain time instead.
+    // [Note] do not use this for the events that must not be merged
+    // (e.g. button clicks or partial updates)
+    //
+    void set_coalescing(bool in_enable)
     {
-      m_window->update();
+      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
+      m_coalescing.store(in_enable, std::memory_order_relaxed);
+      if (in_enable == false)
+        m_coalesce_map.clear();
     }
-
-  private:
-    // member variables --------------------------------------------------------
-    base::WindowBase *m_window;
-    base::EventQueue *m_user_event_queue;
-
-    Gtk::Box    *m_horiz_box;
-    Gtk::Label  *m_label;
-    std::string  m_label_str;
-    bool  m_is_updated;
-
-    friend class WindowData;
-    friend class WindowView;
-  };
-
-  // ===========================================================================
-  //  ButtonData class (GtkButton)
-  // ===========================================================================
-  class ButtonData : public WidgetData
-  {
-  protected:
     // -------------------------------------------------------------------------
-    // ButtonData destructor
+    // is_coalescing
     // -------------------------------------------------------------------------
-    ~ButtonData() override
+    bool is_coalescing() const
     {
-      delete m_button;
+      return m_coalescing.load(std::memory_order_relaxed);
     }
-
     // -------------------------------------------------------------------------
-    // ButtonData constructor
+    // get_coalesced_num
     // -------------------------------------------------------------------------
-    ButtonData(base::WindowBase *in_window,
-               const char *in_label_str,
-               const char *in_button_str,
-               void *in_user_data = nullptr,
-               void (*in_clicked_func)(void *in_user_data) = nullptr,
-               void (*in_pressed_func)(void *in_user_data) = nullptr,
-               void (*in_released_func)(void *in_user_data) = nullptr,
-               base::EventQueue *in_user_event_queue = nullptr) :
-            WidgetData(in_window, in_label_str, in_user_event_queue),
-            m_button_str(in_button_str),
-            m_user_data(in_user_data),
-            m_clicked_func(in_clicked_func),
-            m_pressed_func(in_pressed_func),
-            m_released_func(in_released_func),
-            m_button(nullptr)
+    size_t get_coalesced_num() const
     {
+      return m_coalesced_num.load(std::memory_order_relaxed);
     }
-    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // create
+    // set_swap_drain
     // -------------------------------------------------------------------------
-    Gtk::Box *create() override
+    // In the swap-and-drain mode, process_events() moves the pending batch out
+    // under the queue lock and invokes the handlers after releasing it, so a
+    // slow handler never blocks push() (the order and the in_last_only
+    // semantics are kept within the batch). A handler can also push() to the
+    // same queue in this mode (the event is processed in the next call).
+    // [Note] the ring buffer backend always works this way
+    //
+    void set_swap_drain(bool in_enable)
     {
-      Gtk::Box  *box = WidgetData::create();
-      if (box == nullptr)
-        return nullptr;
-      m_button = new Gtk::Button(m_button_str.c_str());
-      if (m_button == nullptr)
-        return nullptr;
-      m_button->signal_clicked().connect(
-              sigc::mem_fun(*this, &ButtonData::queue_button_clicked));
-      m_button->signal_pressed().connect(
-              sigc::mem_fun(*this, &ButtonData::queue_button_pressed));
-      m_button->signal_released().connect(
-              sigc::mem_fun(*this, &ButtonData::queue_button_released));
-      box->pack_end(*m_button, Gtk::PACK_SHRINK);
-      return box;
+      m_swap_drain.store(in_enable, std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // queue_button_clicked
+    // is_swap_drain
     // -------------------------------------------------------------------------
-    void queue_button_clicked()
+    bool is_swap_drain() const
     {
-      if (m_clicked_func == nullptr)
-        return;
-      push_event(process_button_clicked);
+      return m_swap_drain.load(std::memory_order_relaxed) || is_ring_buffer();
     }
     // -------------------------------------------------------------------------
-    // queue_button_pressed
+    // set_capacity
     // -------------------------------------------------------------------------
-    void queue_button_pressed()
+    // Bounds the number of pending events (in_capacity = 0 : unbounded, the
+    // default). When the queue is full, push() applies in_policy.
+    // [Note] with the ring buffer backend, the events in the ring count
+    // against in_capacity too (the bound may be exceeded by one event per
+    // concurrent producer). Only OVERFLOW_DROP_NEWEST and OVERFLOW_BLOCK are
+    // supported there: a producer can not remove the oldest event from the
+    // ring, so the other policies are refused (returns false).
+    // OVERFLOW_BLOCK must not be used when the producer is also the consumer
+    // of the queue (it would wait forever).
+    // The coroutine resumes of an EventQueueExecutor are never dropped (they
+    // are not events, see defer_resume)
+    //
+    bool set_capacity(size_t in_capacity,
+                      OverflowPolicy in_policy = OVERFLOW_DROP_OLDEST)
     {
-      if (m_pressed_func == nullptr)
-        return;
-      push_event(process_button_pressed);
+      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
+      if (m_ring.load() != nullptr && is_ring_policy(in_capacity, in_policy) == false)
+        return false;
+      m_capacity.store(in_capacity, std::memory_order_relaxed);
+      m_overflow_policy.store(in_policy, std::memory_order_relaxed);
+      if (m_space_waiter_num != 0)
+        m_space_cond.notify_all();
+      return true;
     }
     // -------------------------------------------------------------------------
-    // queue_button_released
+    // get_capacity
     // -------------------------------------------------------------------------
-    void queue_button_released()
+    size_t get_capacity() const
     {
-      if (m_released_func == nullptr)
-        return;
-      push_event(process_button_released);
+      return m_capacity.load(std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // process_button_clicked
+    // get_overflow_policy
     // -------------------------------------------------------------------------
-    static void process_button_clicked(base::EventData *in_event)
+    OverflowPolicy get_overflow_policy() const
     {
-      auto  *button = (ButtonData *)in_event->get_source();
-      button->m_clicked_func(button->m_user_data);
+      return m_overflow_policy.load(std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // process_button_pressed
+    // get_overflow_stats
     // -------------------------------------------------------------------------
-    static void process_button_pressed(base::EventData *in_event)
+    OverflowStats get_overflow_stats() const
     {
-      auto  *button = (ButtonData *)in_event->get_source();
-      button->m_pressed_func(button->m_user_data);
+      OverflowStats stats;
+      stats.m_dropped_num = m_dropped_num.load(std::memory_order_relaxed);
+      stats.m_coalesced_num = m_overflow_coalesced_num.load(std::memory_order_relaxed);
+      stats.m_blocked_num = m_blocked_num.load(std::memory_order_relaxed);
+      return stats;
     }
     // -------------------------------------------------------------------------
-    // process_button_released
+    // reset_overflow_stats
     // -------------------------------------------------------------------------
-    static void process_button_released(base::EventData *in_event)
+    void reset_overflow_stats()
     {
-      auto  *button = (ButtonData *)in_event->get_source();
-      button->m_released_func(button->m_user_data);
+      m_dropped_num.store(0, std::memory_order_relaxed);
+      m_overflow_coalesced_num.store(0, std::memory_order_relaxed);
+      m_blocked_num.store(0, std::memory_order_relaxed);
     }
-
-  private:
-    // member variables --------------------------------------------------------
-    Gtk::Button *m_button;
-    std::string m_button_str;
-    void *m_user_data;
-    void (*m_clicked_func)(void *in_user_data);
-    void (*m_pressed_func)(void *in_user_data);
-    void (*m_released_func)(void *in_user_data);
-
-    friend class WindowData;
-    friend class WindowView;
-  };
-
-  // ===========================================================================
-  //  LabelUpdate class
-  // ===========================================================================
-  class LabelUpdate : public base::EventData
-  {
-  protected:
-      // member variables --------------------------------------------------------
-      bool m_value_updated;
-      std::string m_text;
-
-      // -------------------------------------------------------------------------
-      // LabelUpdate constructor
-      // -------------------------------------------------------------------------
-      LabelUpdate(const char *in_text,
-                  WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          m_text(in_text),
-          m_value_updated(true),
-          base::EventData(in_source_widget, in_handler)
-      {
-      }
-      // -------------------------------------------------------------------------
-      // LabelUpdate destructor
-      // -------------------------------------------------------------------------
-      ~LabelUpdate() override = default;
-
-      friend class LabelData;
-  };
-
-  // ===========================================================================
-  //  LabelData class (GtkLabel)
-  // ===========================================================================
-  class LabelData : public WidgetData
-  {
-  public:
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // get_value
-      // -------------------------------------------------------------------------
-      bool get_value(std::string *io_text, bool in_compare = false)
-      {
-        if (io_text == nullptr)
-          return false;
-        std::lock_guard<std::mutex> lock(m_text_mutex);
-        if (in_compare)
-          if (*io_text == m_text)
-            return false;
-        *io_text = m_text;
-        return true;
-      }
-      // -------------------------------------------------------------------------
-      // set_value
-      // -------------------------------------------------------------------------
-      void set_value(const char *in_text, bool in_invoke_update = true)
-      {
-        if (m_static_text == nullptr)
-        {
-          m_initial.m_text = in_text;
-          return;
-        }
-        auto *update = new LabelUpdate(in_text, this, process_update);
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
-      }
-
-  protected:
-      // -------------------------------------------------------------------------
-      // LabelData constructor
-      // -------------------------------------------------------------------------
-      LabelData(base::WindowBase *in_window,
-                const char *in_label_str,
-                const char *in_text,
-                base::EventQueue *in_user_event_queue = nullptr) :
-          WidgetData(in_window, in_label_str, in_user_event_queue),
-          m_initial(in_text, nullptr, nullptr),
-          m_static_text(nullptr)
-      {
-      }
-      // -------------------------------------------------------------------------
-      // LabelData destructor
-      // -------------------------------------------------------------------------
-      ~LabelData() override
-      {
-        delete m_static_text;
-      }
-
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // create
-      // -------------------------------------------------------------------------
-      Gtk::Box *create() override
-      {
-        Gtk::Box  *box = WidgetData::create();
-        if (box == nullptr)
-          return nullptr;
-        m_text = m_initial.m_text;
-        m_static_text = new Gtk::Label(m_text);
-        if (m_static_text == nullptr)
-          return nullptr;
-        box->pack_end(*m_static_text, Gtk::PACK_SHRINK);
-        return box;
-      }
-      // -------------------------------------------------------------------------
-      // process_update
-      // -------------------------------------------------------------------------
-      static void process_update(base::EventData *in_update)
-      {
-        auto *update = (LabelUpdate *) in_update;
-        auto *label = (LabelData *) update->get_source();
-
-        if (update->m_value_updated)
-        {
-          label->m_static_text->set_label(update->m_text);
-          return;
-        }
-      }
-
-  private:
-      Gtk::Label *m_static_text;
-      LabelUpdate  m_initial;
-
-      std::string m_text;
-      std::mutex  m_text_mutex;
-
-      friend class WindowData;
-      friend class WindowView;
-  };
-
-  // ===========================================================================
-  //  EntryEvent class
-  // ===========================================================================
-  class EntryEvent : public base::EventData
-  {
-  protected:
-    // member variables --------------------------------------------------------
-    std::string m_text;
-
     // -------------------------------------------------------------------------
-    // EntryEvent constructor
+    // set_stats_enabled
     // -------------------------------------------------------------------------
-    EntryEvent(const std::string &in_text,
-            WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-            base::EventData(in_source_widget, in_handler),
-            m_text(in_text)
+    // Enables the depth / rate / latency statistics (disabled by default).
+    // When disabled, push() and the dispatch only test one atomic flag.
+    // [Note] enabling also resets the statistics. Events pushed before
+    // enabling are not counted in the latency
+    //
+    void set_stats_enabled(bool in_enable)
     {
+      if (in_enable)
+        reset_stats();
+      m_stats_enabled.store(in_enable, std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // EntryEvent destructor
-    // -------------------------------------------------------------------------
-    ~EntryEvent() override = default;
-
-    friend class EntryData;
-  };
-
-  // ===========================================================================
-  //  EntryUpdate class
-  // ===========================================================================
-  class EntryUpdate : public base::EventData
-  {
-  protected:
-      // member variables --------------------------------------------------------
-      bool m_value_updated;
-      std::string m_text;
-
-      // -------------------------------------------------------------------------
-      // EntryUpdate constructor
-      // -------------------------------------------------------------------------
-      EntryUpdate(const std::string &in_text,
-                  WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          m_text(in_text),
-          m_value_updated(true),
-          base::EventData(in_source_widget, in_handler)
-      {
-      }
-      // -------------------------------------------------------------------------
-      // EntryUpdate destructor
-      // -------------------------------------------------------------------------
-      ~EntryUpdate() override = default;
-
-      friend class EntryData;
-  };
-
-  // ===========================================================================
-  //  EntryData class (GtkEntry)
-  // ===========================================================================
-  class EntryData : public WidgetData
-  {
-  public:
-    // Member functions --------------------------------------------------------
-    // -------------------------------------------------------------------------
-    // get_value
+    // is_stats_enabled
     // -------------------------------------------------------------------------
-    bool get_value(std::string *io_text, bool in_compare = false)
+    bool is_stats_enabled() const
     {
-      if (io_text == nullptr)
-        return false;
-      std::lock_guard<std::mutex> lock(m_text_mutex);
-      if (in_compare)
-        if (*io_text == m_text)
-          return false;
-      *io_text = m_text;
-      return true;
+      return m_stats_enabled.load(std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // set_value
+    // get_stats
     // -------------------------------------------------------------------------
-    void set_value(const std::string &in_text, bool in_invoke_update = true)
+    Stats get_stats()
     {
-      if (m_entry == nullptr)
-      {
-        m_initial.m_text = in_text;
-        return;
-      }
-      auto *update = new EntryUpdate(in_text, this, process_update);
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      Stats stats;
+      stats.m_depth = size();
+      stats.m_peak_depth = std::max(m_peak_depth.load(std::memory_order_relaxed),
+                                    stats.m_depth);
+      stats.m_enqueue_num = m_enqueue_num.load(std::memory_order_relaxed);
+      stats.m_dispatch_num = m_dispatch_num.load(std::memory_order_relaxed);
+      stats.m_enqueue_rate = 0;
+      int64_t elapsed_ns = now_ns() - m_stats_start_ns.load(std::memory_order_relaxed);
+      if (m_stats_start_ns.load(std::memory_order_relaxed) != 0 && elapsed_ns > 0)
+        stats.m_enqueue_rate = (double)stats.m_enqueue_num * 1e9 / (double)elapsed_ns;
+      std::lock_guard<std::mutex> lock(m_stats_mutex);
+      stats.m_latency = m_latency;
+      return stats;
     }
-
-  protected:
     // -------------------------------------------------------------------------
-    // EntryData constructor
+    // reset_stats
     // -------------------------------------------------------------------------
-    EntryData(base::WindowBase *in_window,
-              const char *in_label_str,
-              std::string *in_user_text,
-              int in_max_length = -1,
-              void *in_user_data = nullptr,
-              void (*in_changed_func)(void *, std::string) = nullptr,
-              void (*in_done_func)(void *, std::string) = nullptr,
-              base::EventQueue *in_user_event_queue = nullptr) :
-            WidgetData(in_window, in_label_str, in_user_event_queue),
-            m_user_text(in_user_text),
-            m_max_length(in_max_length),
-            m_initial("", nullptr, nullptr),
-            m_user_data(in_user_data),
-            m_changed_func(in_changed_func),
-            m_done_func(in_done_func),
-            m_entry(nullptr)
+    void reset_stats()
     {
-      if (in_user_text != nullptr)
-        m_initial.m_text = *in_user_text;
+      std::lock_guard<std::mutex> lock(m_stats_mutex);
+      m_peak_depth.store(0, std::memory_order_relaxed);
+      m_enqueue_num.store(0, std::memory_order_relaxed);
+      m_dispatch_num.store(0, std::memory_order_relaxed);
+      m_stats_start_ns.store(now_ns(), std::memory_order_relaxed);
+      m_latency.clear();
+      m_latency_index.clear();
     }
     // -------------------------------------------------------------------------
-    // EntryData destructor
+    // set_lane_mode
     // -------------------------------------------------------------------------
-    ~EntryData() override
+    // Selects how the priority lanes are drained. LANE_MODE_FIFO (default)
+    // ignores the event priority. LANE_MODE_STRICT always dispatches the
+    // highest priority event first. LANE_MODE_WEIGHTED takes up to
+    // "weight" events from each lane in turn, so the low priority lane is
+    // never starved. Any mode other than FIFO uses the batch dispatch
+    // (the handlers are invoked outside the queue lock).
+    //
+    void set_lane_mode(LaneMode in_mode)
     {
-      delete m_entry;
+      m_lane_mode.store(in_mode, std::memory_order_relaxed);
     }
-
-    // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // create
+    // get_lane_mode
     // -------------------------------------------------------------------------
-    Gtk::Box *create() override
+    LaneMode get_lane_mode() const
     {
-      Gtk::Box  *box = WidgetData::create();
-      if (box == nullptr)
-        return nullptr;
-      m_text = m_initial.m_text;
-      m_entry = new Gtk::Entry();
-      if (m_entry == nullptr)
-        return nullptr;
-      if (m_max_length >= 0)
-        m_entry->set_max_length(m_max_length);
-      m_entry->set_text(m_text);
-      m_entry->signal_changed().connect(
-              sigc::mem_fun(*this, &EntryData::queue_changed));
-      m_entry->signal_editing_done().connect(
-              sigc::mem_fun(*this, &EntryData::queue_done));
-      box->pack_end(*m_entry, Gtk::PACK_SHRINK);
-      return box;
+      return m_lane_mode.load(std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // queue_event
+    // set_lane_weight (for LANE_MODE_WEIGHTED)
     // -------------------------------------------------------------------------
-    void queue_event(void (*in_func)(base::EventData *), void (*in_user_func)(void *, std::string))
+    void set_lane_weight(EventPriority in_priority, unsigned int in_weight)
     {
-      std::lock_guard<std::mutex> lock(m_text_mutex);
-      m_text = m_entry->get_buffer()->get_text().c_str();
-      if (in_user_func == nullptr && m_user_text == nullptr)
+      if (in_priority >= EVENT_PRIORITY_NUM)
         return;
-      auto *event = new EntryEvent(
-              m_text,
-              this, in_func);
-      push_event(event);
+      if (in_weight == 0)
+        in_weight = 1;
+      m_lane_weight[in_priority].store(in_weight, std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // queue_changed
+    // enable_event_fd
     // -------------------------------------------------------------------------
-    void queue_changed()
+    // Creates (once) a non-blocking Linux eventfd that becomes readable while
+    // events are pending and is cleared when process_events() has drained the
+    // queue, so the queue can be watched by epoll / poll / select together
+    // with other descriptors. Returns the fd (-1 if not supported).
+    // [Note] do not read the fd yourself, just call process_events() (or
+    // try_process()) when it becomes readable. The fd is owned by the queue
+    //
+    int enable_event_fd()
     {
-      queue_event(process_changed, m_changed_func);
+#ifdef __linux__
+      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
+      if (m_event_fd.load() >= 0)
+        return m_event_fd.load();
+      int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (fd < 0)
+      {
+        SHL_ERROR_OUT("eventfd() failed");
+        return -1;
+      }
+      m_event_fd_signaled.store(false);
+      m_event_fd.store(fd);
+      if (is_empty_locked() == false)
+        signal_event_fd();
+      return fd;
+#else
+      return -1;
+#endif
     }
     // -------------------------------------------------------------------------
-    // queue_done
+    // get_event_fd
     // -------------------------------------------------------------------------
-    void queue_done()
+    int get_event_fd() const
     {
-      queue_event(process_done, m_done_func);
+      return m_event_fd.load();
     }
     // -------------------------------------------------------------------------
-    // process_changed
+    // get_event_pool
     // -------------------------------------------------------------------------
-    static void process_changed(base::EventData *in_event)
+    // [Note] allocate events with "new (queue->get_event_pool()) SomeEvent()"
+    //
+    EventPool *get_event_pool()
     {
-      auto *event = (EntryEvent *)in_event;
-      auto  *entry = (EntryData *)event->get_source();
-
-      if (entry->m_user_text != nullptr)
-        *(entry->m_user_text) = event->m_text;
-      if (entry->m_changed_func != nullptr)
-        entry->m_changed_func(entry->m_user_data, event->m_text);
+      return &m_event_pool;
     }
     // -------------------------------------------------------------------------
-    // process_done
+    // get_pool_stats
     // -------------------------------------------------------------------------
-    static void process_done(base::EventData *in_event)
+    EventPool::Stats get_pool_stats() const
     {
-      auto *event = (EntryEvent *)in_event;
-      auto  *entry = (EntryData *)event->get_source();
-
-      if (entry->m_user_text != nullptr)
-        *(entry->m_user_text) = event->m_text;
-      if (entry->m_changed_func != nullptr)
-        entry->m_done_func(entry->m_user_data, event->m_text);
+      return m_event_pool.get_stats();
     }
+#ifdef SHL_GTK_COROUTINE
     // -------------------------------------------------------------------------
-    // process_update
+    // EventAwaiter class
     // -------------------------------------------------------------------------
-    static void process_update(base::EventData *in_update)
+    // "co_await queue.next_event(executor)" suspends until an event is pushed
+    // (or notify() is called) and resumes the coroutine on the executor.
+    // The result is true if events are pending (false : e.g. window closed)
+    //
+    class EventAwaiter
     {
-      auto *update = (EntryUpdate *) in_update;
-      auto *entry = (EntryData *) update->get_source();
-
-      if (update->m_value_updated)
+    public:
+      EventAwaiter(EventQueue *in_queue, Executor *in_executor) :
+          m_queue(in_queue), m_executor(in_executor), m_result(false)
       {
-        entry->m_entry->set_text(update->m_text);
-        return;
       }
-    }
-
-  private:
-    Gtk::Entry *m_entry;
-    EntryUpdate  m_initial;
-    int m_max_length;
-
-    std::string m_text;
-    std::mutex  m_text_mutex;
-
-    std::string *m_user_text;
-    void *m_user_data;
-    void (*m_changed_func)(void *, std::string);
-    void (*m_done_func)(void *, std::string);
-
-    friend class WindowData;
-    friend class WindowView;
-  };
-
-  // ===========================================================================
-  //  SpinButtonEvent class
-  // ===========================================================================
-  class SpinButtonEvent : public base::EventData
-  {
-  protected:
-    // member variables --------------------------------------------------------
-    double m_value;
+      bool await_ready() const
+      {
+        return m_queue->empty() == false;
+      }
+      bool await_suspend(std::coroutine_handle<> in_handle)
+      {
+        m_queue->m_awaiters.add(in_handle, m_executor, &m_result);
+        // An event may have been pushed before we were registered
+        if (m_queue->empty() == false && m_queue->m_awaiters.remove(in_handle))
+          return false;
+        return true;
+      }
+      bool await_resume()
+      {
+        return m_queue->empty() == false;
+      }
 
+    private:
+      EventQueue  *m_queue;
+      Executor    *m_executor;
+      bool  m_result;
+    };
     // -------------------------------------------------------------------------
-    // SpinButtonEvent constructor
+    // next_event
     // -------------------------------------------------------------------------
-    SpinButtonEvent(double in_value,
-               WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-            base::EventData(in_source_widget, in_handler),
-            m_value(in_value)
+    // [Note] in_executor = nullptr resumes the coroutine on the pushing thread
+    // (usually the GTK thread, so the coroutine body runs there and blocks
+    // the UI). Pass an executor unless that is intended
+    //
+    EventAwaiter next_event(Executor *in_executor = nullptr)
     {
+      return EventAwaiter(this, in_executor);
     }
     // -------------------------------------------------------------------------
-    // SpinButtonEvent destructor
+    // defer_resume
     // -------------------------------------------------------------------------
-    ~SpinButtonEvent() override = default;
-
-    friend class SpinButtonData;
-  };
-
-  // ===========================================================================
-  //  SpinButtonUpdate class
-  // ===========================================================================
-  class SpinButtonUpdate : public base::EventData
-  {
-  protected:
-    // member variables --------------------------------------------------------
-    bool m_value_updated;
-    bool m_range_updated, m_increments_updated;
-    bool m_wrap_updated, m_numeric_updated;
-    bool m_digits_updated;
-    bool m_adjustment_called; // value, lower, upper, step, page, page_size
-    bool m_configure_called;  // climb_rate, digits
+    // in_handle is resumed by process_events() after the queue locks are
+    // released, so that the coroutine can process, await or push the events
+    // of this queue.
+    // [Note] a resume is not an event: it is never dropped by the overflow
+    // policy and does not count in size(), but empty() and wait() see it
     //
-    double m_value;
-    double m_lower, m_upper;
-    double m_step_increment, m_page_increment;
-    double m_page_size, m_climb_rate;
-    bool m_wrap, m_numeric;
-    guint m_digits;
-
-    // -------------------------------------------------------------------------
-    // SpinButtonUpdate constructor
-    // -------------------------------------------------------------------------
-    SpinButtonUpdate(double in_value,
-                     double in_lower, double in_upper,
-                     double in_step_increment,
-                     double in_page_increment,
-                     double in_page_size,
-                     double in_climb_rate,
-                     guint in_digits,
-                     bool in_wrap, bool in_numeric) :
-            m_value(in_value),
-            m_lower(in_lower), m_upper(in_upper),
-            m_step_increment(in_step_increment), m_page_increment(in_page_increment),
-            m_page_size(in_page_size), m_climb_rate(in_climb_rate),
-            m_digits(in_digits),
-            m_wrap(in_wrap), m_numeric(in_numeric),
-            m_value_updated(true),
-            m_range_updated(true), m_increments_updated(true),
-            m_digits_updated(true),
-            m_wrap_updated(true), m_numeric_updated(true),
-            m_adjustment_called(true),
-            m_configure_called(true),
-            base::EventData(nullptr, nullptr)
+    void defer_resume(std::coroutine_handle<> in_handle)
     {
+      {
+        std::lock_guard<std::mutex> lock(m_deferred_mutex);
+        m_deferred.push_back(in_handle);
+        m_deferred_num.fetch_add(1, std::memory_order_release);
+      }
+      notify();
     }
+#endif
     // -------------------------------------------------------------------------
-    // SpinButtonUpdate constructor
+    // push
     // -------------------------------------------------------------------------
-    SpinButtonUpdate(WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-            m_value(0),
-            m_lower(0), m_upper(0),
-            m_step_increment(1), m_page_increment(10),
-            m_page_size(0), m_climb_rate(0),
-            m_digits(0),
-            m_wrap(false), m_numeric(false),
-            m_value_updated(false),
-            m_range_updated(false), m_increments_updated(false),
-            m_digits_updated(false),
-            m_wrap_updated(false), m_numeric_updated(false),
-            m_adjustment_called(false),
-            m_configure_called(false),
-            base::EventData(in_source_widget, in_handler)
+    // [Note] in_handler receives a temporary EventData that only has the
+    // source (nothing is allocated)
+    //
+    void push(void *in_source, void (*in_handler)(EventData *),
+              EventPriority in_priority = EVENT_PRIORITY_NORMAL)
     {
+      push_record(make_record(in_source, (void (*)())in_handler,
+                              EVENT_OPCODE_CALL, in_priority));
     }
     // -------------------------------------------------------------------------
-    // SpinButtonUpdate destructor
+    // push
     // -------------------------------------------------------------------------
-    ~SpinButtonUpdate() override = default;
-
-    friend class SpinButtonData;
-  };
-
-  // ===========================================================================
-  //  SpinButtonData class (GtkSpinButton)
-  // ===========================================================================
-  class SpinButtonData : public WidgetData
-  {
-  public:
-    // Member functions --------------------------------------------------------
+    // Pushes an inline event (in_value is stored in the queue by value)
+    //
+    void push(void *in_source, EventRecordHandler in_handler,
+              const EventValue &in_value,
+              EventPriority in_priority = EVENT_PRIORITY_NORMAL)
+    {
+      EventRecord record = make_record(in_source, (void (*)())in_handler,
+                                       EVENT_OPCODE_VALUE, in_priority);
+      record.m_payload = in_value;
+      push_record(record);
+    }
     // -------------------------------------------------------------------------
-    // get_value
+    // push
     // -------------------------------------------------------------------------
-    bool get_value(double *io_value, bool in_compare = false)
+    // [Note] the queue owns in_event (deleted after the dispatch)
+    //
+    void push(EventData *in_event,
+              EventPriority in_priority = EVENT_PRIORITY_NORMAL)
     {
-      if (io_value == nullptr)
-        return false;
-      std::lock_guard<std::mutex> lock(m_value_mutex);
-      if (in_compare)
-        if (*io_value == m_value)
-          return false;
-      *io_value = m_value;
-      return true;
+      EventRecord record = make_record(in_event->m_source,
+                                       (void (*)())in_event->m_handler,
+                                       EVENT_OPCODE_BOXED, in_priority);
+      record.m_payload.m_boxed = in_event;
+      push_record(record);
     }
     // -------------------------------------------------------------------------
-    // set_value
+    // push_record
     // -------------------------------------------------------------------------
-    void set_value(double in_value, bool in_invoke_update = true)
+    void push_record(EventRecord in_record)
     {
-      if (m_spin == nullptr)
+      if (m_stats_enabled.load(std::memory_order_relaxed))
+        record_enqueue(&in_record);
+      EventRing *ring = m_ring.load(std::memory_order_acquire);
+      if (ring != nullptr)
       {
-        m_initial.m_value = in_value;
+        // The ring counts against the capacity (only OVERFLOW_DROP_NEWEST and
+        // OVERFLOW_BLOCK are possible here, see set_capacity)
+        size_t capacity = m_capacity.load(std::memory_order_relaxed);
+        if (capacity != 0 && size() >= capacity)
+        {
+          if (m_overflow_policy.load(std::memory_order_relaxed) != OVERFLOW_BLOCK)
+          {
+            release_record(&in_record);
+            m_dropped_num.fetch_add(1, std::memory_order_relaxed);
+            return;
+          }
+          m_blocked_num.fetch_add(1, std::memory_order_relaxed);
+          for (size_t n = 0; capacity != 0 && size() >= capacity; n++)
+          {
+            if (n < 64)
+              std::this_thread::yield();
+            else
+              std::this_thread::sleep_for(std::chrono::microseconds(100));
+            capacity = m_capacity.load(std::memory_order_relaxed);
+          }
+        }
+        // Once something has spilled into the list, keep using the list until
+        // the consumer drains it (preserves the order of a single producer)
+        if (m_overflow_num.load(std::memory_order_acquire) == 0 &&
+            ring->push(in_record))
+        {
+          // Only touch the mutex / condvar when the consumer is sleeping
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (m_waiter_num.load(std::memory_order_relaxed) != 0)
+            notify_waiters();
+          signal_event_fd();
+          resume_awaiters();
+          return;
+        }
+        // (the capacity was checked above, the list only takes the events
+        // that do not fit in the ring)
+        std::unique_lock<std::mutex> lock(m_event_queue_mutex);
+        push_back_locked(in_record);
+        m_overflow_num.fetch_add(1, std::memory_order_release);
+        m_new_event_cond.notify_all();
+        signal_event_fd();
+        lock.unlock();
+        resume_awaiters();
         return;
       }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_value = in_value;
-      update->m_value_updated = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      std::unique_lock<std::mutex> lock(m_event_queue_mutex);
+      if (make_room_locked(lock, &in_record) == false)
+        return;
+      if (m_coalescing.load(std::memory_order_relaxed))
+        push_coalesced_locked(in_record);
+      else
+        push_back_locked(in_record);
+      // (use_ring_buffer() was called meanwhile: the consumer drains the list
+      // only while m_overflow_num != 0)
+      if (m_ring.load(std::memory_order_relaxed) != nullptr)
+        m_overflow_num.fetch_add(1, std::memory_order_release);
+      m_new_event_cond.notify_all();
+      signal_event_fd();
+      lock.unlock();
+      resume_awaiters(); // (never with the queue lock, an awaiter may push)
     }
     // -------------------------------------------------------------------------
-    // set_adjustment
+    // notify
     // -------------------------------------------------------------------------
-    void set_adjustment(double in_value,
-                        double in_lower, double in_upper,
-                        double in_step_increment = 1,
-                        double in_page_increment = 10,
-                        double in_page_size = 0,
-                        bool in_invoke_update = true)
+    // [Note] also makes the event fd readable (e.g. to tell the window close)
+    //
+    void notify()
     {
-      if (m_spin == nullptr)
-      {
-        m_initial.m_value = in_value;
-        m_initial.m_lower = in_lower;
-        m_initial.m_upper = in_upper;
-        m_initial.m_step_increment = in_step_increment;
-        m_initial.m_page_increment = in_page_increment;
-        m_initial.m_page_size = in_page_size;
-        return;
-      }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_value = in_value;
-      update->m_lower = in_lower;
-      update->m_upper = in_upper;
-      update->m_step_increment = in_step_increment;
-      update->m_page_increment = in_page_increment;
-      update->m_page_size = in_page_size;
-      update->m_adjustment_called = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      notify_waiters();
+      signal_event_fd();
+      resume_awaiters();
     }
     // -------------------------------------------------------------------------
-    // set_configure
+    // size
     // -------------------------------------------------------------------------
-    void set_configure(double in_climb_rate, guint in_digits, bool in_invoke_update = true)
+    // [Note] the number of pending events (approximate while producers or a
+    // consumer are running)
+    //
+    size_t size() const
     {
-      if (m_spin == nullptr)
-      {
-        m_initial.m_climb_rate = in_climb_rate;
-        m_initial.m_digits = in_digits;
-        return;
-      }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_climb_rate = in_climb_rate;
-      update->m_digits = in_digits;
-      update->m_configure_called = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      size_t num = m_list_num.load(std::memory_order_relaxed) +
+                   m_carry_num.load(std::memory_order_relaxed);
+      EventRing *ring = m_ring.load(std::memory_order_acquire);
+      if (ring != nullptr)
+        num += ring->size();
+      return num;
     }
     // -------------------------------------------------------------------------
-    // set_range
+    // empty
     // -------------------------------------------------------------------------
-    void set_range(double in_lower, guint in_upper, bool in_invoke_update = true)
+    // [Note] false also while coroutine resumes are pending (see defer_resume)
+    //
+    bool empty() const
     {
-      if (m_spin == nullptr)
-      {
-        m_initial.m_lower = in_lower;
-        m_initial.m_upper = in_upper;
-        return;
-      }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_lower = in_lower;
-      update->m_upper = in_upper;
-      update->m_range_updated = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      return size() == 0 && has_deferred() == false;
     }
     // -------------------------------------------------------------------------
-    // set_increments
+    // wait
     // -------------------------------------------------------------------------
-    void set_increments(double in_step_increment, guint in_page_increment, bool in_invoke_update = true)
+    void wait()
     {
-      if (m_spin == nullptr)
+      m_waiter_num.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
       {
-        m_initial.m_step_increment = in_step_increment;
-        m_initial.m_page_increment = in_page_increment;
-        return;
+        std::unique_lock<std::mutex> lock(m_event_queue_mutex);
+        if (is_empty_locked())
+          m_new_event_cond.wait(lock);
       }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_step_increment = in_step_increment;
-      update->m_page_increment = in_page_increment;
-      update->m_increments_updated = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      m_waiter_num.fetch_sub(1, std::memory_order_relaxed);
     }
     // -------------------------------------------------------------------------
-    // set_digits
+    // wait_for
     // -------------------------------------------------------------------------
-    void set_digits(guint in_digits, bool in_invoke_update = true)
+    // [Note] returns true if there are pending events
+    //
+    bool wait_for(std::chrono::steady_clock::duration in_timeout)
     {
-      if (m_spin == nullptr)
-      {
-        m_initial.m_digits = in_digits;
-        return;
-      }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_digits = in_digits;
-      update->m_digits_updated = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      return wait_until(to_deadline(in_timeout));
     }
     // -------------------------------------------------------------------------
-    // set_wrap
+    // wait_until
     // -------------------------------------------------------------------------
-    void set_wrap(bool in_wrap, bool in_invoke_update = true)
+    // [Note] returns true if there are pending events
+    //
+    bool wait_until(std::chrono::steady_clock::time_point in_deadline)
     {
-      if (m_spin == nullptr)
+      bool pending;
+      m_waiter_num.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
       {
-        m_initial.m_value = in_wrap;
-        return;
+        std::unique_lock<std::mutex> lock(m_event_queue_mutex);
+        if (is_empty_locked())
+          m_new_event_cond.wait_until(lock, in_deadline);
+        pending = !is_empty_locked();
       }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_wrap = in_wrap;
-      update->m_wrap_updated = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      m_waiter_num.fetch_sub(1, std::memory_order_relaxed);
+      return pending;
     }
     // -------------------------------------------------------------------------
-    // set_numeric
+    // process_events
     // -------------------------------------------------------------------------
-    void set_numeric(bool in_numeric, bool in_invoke_update = true)
+    void process_events(bool in_last_only = false)
     {
-      if (m_spin == nullptr)
-      {
-        m_initial.m_numeric = in_numeric;
-        return;
-      }
-      auto *update = new SpinButtonUpdate(this, process_update);
-      update->m_numeric = in_numeric;
-      update->m_numeric_updated = true;
-      push_update(update);
-      if (in_invoke_update)
-        invoke_update();
+      process_events_impl(in_last_only, SIZE_MAX,
+                          std::chrono::steady_clock::time_point::max(), false);
     }
-
-  protected:
     // -------------------------------------------------------------------------
-    // SpinButtonData constructor
+    // process_events
     // -------------------------------------------------------------------------
-    SpinButtonData( base::WindowBase *in_window,
-                    const char *in_label_str,
-                    double *in_user_variable,
-                    double in_lower, double in_upper,
-                    double in_step_increment = 1,
-                    double in_page_increment = 10,
-                    double in_page_size = 0,
-                    double in_climb_rate = 0,
-                    guint in_digits = 0,
-                    void *in_user_data = nullptr,
-                    void (*in_value_changed_func)(void *, double) = nullptr,
-                    bool in_wrap = false, bool in_numeric = false,
-                    base::EventQueue *in_user_event_queue = nullptr) :
-        WidgetData(in_window, in_label_str, in_user_event_queue),
-        m_user_variable(in_user_variable),
-        m_initial(0, in_lower, in_upper, in_step_increment,
-                      in_page_increment, in_page_size, in_climb_rate,
-                      in_digits, in_wrap, in_numeric),
-        m_user_data(in_user_data),
-        m_value_changed_func(in_value_changed_func),
-        m_spin(nullptr), m_value(0)
+    // Processes at most in_max_count events and stops when in_max_time has
+    // elapsed. Returns the number of events left in the queue.
+    // [Note] with the ring buffer or the swap-and-drain mode, the rest of the
+    // drained batch is kept (in order) and processed first by the next call
+    //
+    size_t process_events(size_t in_max_count,
+                          std::chrono::steady_clock::duration in_max_time,
+                          bool in_last_only = false)
     {
-      if (in_user_variable != nullptr)
-        m_initial.m_value = *in_user_variable;
+      return process_events_impl(in_last_only, in_max_count,
+                                 to_deadline(in_max_time), false);
     }
     // -------------------------------------------------------------------------
-    // SpinButtonData destructor
+    // try_process
     // -------------------------------------------------------------------------
-    ~SpinButtonData() override
+    // Same as process_events(), but never waits for a lock held by another
+    // consumer or by producers. Returns the number of events left.
+    //
+    size_t try_process(bool in_last_only = false)
     {
-      delete m_spin;
+      return process_events_impl(in_last_only, SIZE_MAX,
+                                 std::chrono::steady_clock::time_point::max(), true);
     }
 
+  protected:
     // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
-    // create
+    // notify_waiters
     // -------------------------------------------------------------------------
-    Gtk::Box *create() override
+    void notify_waiters()
     {
-      Gtk::Box  *box = WidgetData::create();
-      if (box == nullptr)
-        return nullptr;
-      if (m_user_variable != nullptr)
-        *m_user_variable = m_initial.m_value;
-      m_value = m_initial.m_value;
-      m_spin = new Gtk::SpinButton(
-        Gtk::Adjustment::create(
-                m_value,
-                m_initial.m_lower, m_initial.m_upper,
-                m_initial.m_step_increment,
-                m_initial.m_page_increment, m_initial.m_page_size),
-        m_initial.m_climb_rate, m_initial.m_digits);
-      if (m_spin == nullptr)
-        return nullptr;
-      m_spin->set_wrap(m_initial.m_wrap);
-      m_spin->set_numeric(m_initial.m_numeric);
-      m_spin->signal_changed().connect(
-              sigc::mem_fun(*this, &SpinButtonData::queue_value_changed));
-      box->pack_end(*m_spin, Gtk::PACK_SHRINK);
-      return box;
+      std::lock_guard<std::mutex> lock(m_event_queue_mutex);
+      m_new_event_cond.notify_all();
     }
     // -------------------------------------------------------------------------
-    // queue_value_changed
+    // signal_event_fd
     // -------------------------------------------------------------------------
-    void queue_value_changed()
+    // [Note] only the first push after a drain writes to the fd
+    //
+    void signal_event_fd()
     {
-      std::lock_guard<std::mutex> lock(m_value_mutex);
-      m_value = m_spin->get_value();
-      mark_as_updated();
-      if (m_value_changed_func == nullptr && m_user_variable == nullptr)
+#ifdef __linux__
+      int fd = m_event_fd.load();
+      if (fd < 0)
         return;
-      auto *event = new SpinButtonEvent(
-              m_value,
-              this, process_value_changed);
-      push_event(event);
+      if (m_event_fd_signaled.exchange(true))
+        return;
+      uint64_t value = 1;
+      if (write(fd, &value, sizeof(value)) < 0)
+      {
+        SHL_WARNING_OUT("write() to eventfd failed");
+      }
+#endif
     }
     // -------------------------------------------------------------------------
-    // process_value_changed
+    // clear_event_fd
     // -------------------------------------------------------------------------
-    static void process_value_changed(base::EventData *in_event)
+    // [Note] called by the consumer after draining. The queue is re-checked
+    // after clearing, so a push racing with the drain is never lost
+    //
+    void clear_event_fd()
     {
-      auto *event = (SpinButtonEvent *)in_event;
-      auto  *spin = (SpinButtonData *)event->get_source();
-
-      if (spin->m_user_variable != nullptr)
-        *(spin->m_user_variable) = event->m_value;
-      if (spin->m_value_changed_func != nullptr)
-        spin->m_value_changed_func(spin->m_user_data, event->m_value);
+#ifdef __linux__
+      int fd = m_event_fd.load();
+      if (fd < 0)
+        return;
+      if (m_event_fd_signaled.load() == false || empty() == false)
+        return;
+      m_event_fd_signaled.store(false);
+      uint64_t value;
+      if (read(fd, &value, sizeof(value)) < 0)
+      {
+        SHL_TRACE_OUT("eventfd was already cleared");
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (empty() == false)
+        signal_event_fd();
+#endif
     }
     // -------------------------------------------------------------------------
-    // process_update
+    // is_empty_locked (m_event_queue_mutex needs to be locked)
     // -------------------------------------------------------------------------
-    static void process_update(base::EventData *in_update)
+    bool is_empty_locked() const
     {
-      auto *update = (SpinButtonUpdate *)in_update;
-      auto  *spin = (SpinButtonData *)update->get_source();
-
-      if (update->m_value_updated)
+      if (m_event_data_queue.empty() == false)
+        return false;
+      if (m_carry_num.load(std::memory_order_relaxed) != 0)
+        return false;
+      EventRing *ring = m_ring.load(std::memory_order_acquire);
+      if (ring != nullptr && ring->empty() == false)
+        return false;
+      return has_deferred() == false;
+    }
+    // -------------------------------------------------------------------------
+    // push_coalesced_locked (m_event_queue_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    void push_coalesced_locked(const EventRecord &in_record)
+    {
+      CoalesceSlot &slot = m_coalesce_map[EventKey(in_record)];
+      if (slot.m_record != nullptr)
       {
-        spin->m_spin->set_value(update->m_value);
+        release_record(slot.m_record);
+        recycle_node_locked(slot.m_it);
+        m_coalesced_num.fetch_add(1, std::memory_order_relaxed);
+      }
+      slot.m_it = push_back_locked(in_record);
+      slot.m_record = &(*slot.m_it);
+    }
+    // -------------------------------------------------------------------------
+    // release_coalesce_slot_locked (m_event_queue_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    // [Note] the map entries are kept (only cleared) so that the steady state
+    // does not allocate
+    //
+    void release_coalesce_slot_locked(const EventRecord &in_record)
+    {
+      auto it = m_coalesce_map.find(EventKey(in_record));
+      if (it != m_coalesce_map.end() && it->second.m_record == &in_record)
+        it->second.m_record = nullptr;
+    }
+    // -------------------------------------------------------------------------
+    // resume_awaiters
+    // -------------------------------------------------------------------------
+    void resume_awaiters()
+    {
+#ifdef SHL_GTK_COROUTINE
+      if (m_awaiters.has_awaiter())
+        m_awaiters.resume_all(true);
+#endif
+    }
+    // -------------------------------------------------------------------------
+    // has_deferred
+    // -------------------------------------------------------------------------
+    bool has_deferred() const
+    {
+#ifdef SHL_GTK_COROUTINE
+      return m_deferred_num.load(std::memory_order_acquire) != 0;
+#else
+      return false;
+#endif
+    }
+    // -------------------------------------------------------------------------
+    // resume_deferred (no queue lock may be held)
+    // -------------------------------------------------------------------------
+    void resume_deferred()
+    {
+#ifdef SHL_GTK_COROUTINE
+      if (m_deferred_num.load(std::memory_order_acquire) == 0)
         return;
+      std::vector<std::coroutine_handle<>> list;
+      {
+        std::lock_guard<std::mutex> lock(m_deferred_mutex);
+        list.swap(m_deferred);
+        m_deferred_num.store(0, std::memory_order_relaxed);
       }
-      if (update->m_adjustment_called)
+      for (auto it = list.begin(); it != list.end(); it++)
+        (*it).resume();
+#endif
+    }
+    // -------------------------------------------------------------------------
+    // record_enqueue
+    // -------------------------------------------------------------------------
+    // [Note] the depth is sampled before the event is added (the peak is an
+    // approximation while other producers are running)
+    //
+    void record_enqueue(EventRecord *io_record)
+    {
+      io_record->m_enqueue_ns = now_ns();
+      m_enqueue_num.fetch_add(1, std::memory_order_relaxed);
+      size_t depth = size() + 1;
+      size_t peak = m_peak_depth.load(std::memory_order_relaxed);
+      while (depth > peak &&
+             m_peak_depth.compare_exchange_weak(peak, depth, std::memory_order_relaxed) == false)
       {
-        spin->m_spin->set_adjustment(Gtk::Adjustment::create(
-                update->m_value,
-                update->m_lower, update->m_upper,
-                update->m_step_increment,
-                update->m_page_increment, update->m_page_size));
-        return;
       }
-      if (update->m_configure_called)
+    }
+    // -------------------------------------------------------------------------
+    // dispatch
+    // -------------------------------------------------------------------------
+    // [Note] the caller releases the record (release_record()) afterwards
+    //
+    void dispatch(const EventRecord &in_record)
+    {
+      if (m_stats_enabled.load(std::memory_order_relaxed))
       {
-        spin->m_spin->configure(Glib::RefPtr<Gtk::Adjustment>(nullptr),
-                                update->m_climb_rate, update->m_digits);
-        return;
+        m_dispatch_num.fetch_add(1, std::memory_order_relaxed);
+        if (in_record.m_enqueue_ns != 0)  // (0: pushed before enabled)
+          record_latency(in_record);
       }
-      if (update->m_range_updated)
+      switch (in_record.m_opcode)
       {
-        spin->m_spin->set_range(update->m_lower,
-                                update->m_upper);
-        return;
+        case EVENT_OPCODE_BOXED:
+          in_record.m_payload.m_boxed->invoke_handler();
+          break;
+        case EVENT_OPCODE_CALL:
+        {
+          auto handler = (void (*)(EventData *))in_record.m_handler;
+          if (handler == nullptr)
+            break;
+          EventData event_data(in_record.m_source, handler);
+          handler(&event_data);
+          break;
+        }
+        case EVENT_OPCODE_VALUE:
+          ((EventRecordHandler)in_record.m_handler)(in_record);
+          break;
+        default:
+          break;
       }
-      if (update->m_increments_updated)
+    }
+    // -------------------------------------------------------------------------
+    // record_latency
+    // -------------------------------------------------------------------------
+    void record_latency(const EventRecord &in_record)
+    {
+      int64_t latency = now_ns() - in_record.m_enqueue_ns;
+      auto latency_ns = (uint64_t)std::max<int64_t>(latency, 0);
+      size_t bucket = 0;
+      while (bucket < LatencyHistogram::BUCKET_NUM - 1 &&
+             (latency_ns >> (bucket + 1)) != 0)
+        bucket++;
+      std::lock_guard<std::mutex> lock(m_stats_mutex);
+      auto result = m_latency_index.emplace(in_record.m_handler, m_latency.size());
+      if (result.second)
       {
-        spin->m_spin->set_increments(update->m_step_increment,
-                                     update->m_page_increment);
-        return;
+        m_latency.push_back(LatencyHistogram());  // (value-initialized = zero)
+        m_latency.back().m_handler = in_record.m_handler;
       }
-      if (update->m_digits_updated)
+      LatencyHistogram *histogram = &m_latency[result.first->second];
+      histogram->m_count++;
+      histogram->m_total_ns += latency_ns;
+      histogram->m_max_ns = std::max(histogram->m_max_ns, latency_ns);
+      histogram->m_buckets[bucket]++;
+    }
+    // -------------------------------------------------------------------------
+    // is_ring_policy
+    // -------------------------------------------------------------------------
+    // [Note] the overflow policies that the ring buffer backend supports
+    //
+    static bool is_ring_policy(size_t in_capacity, OverflowPolicy in_policy)
+    {
+      return in_capacity == 0 ||
+             in_policy == OVERFLOW_DROP_NEWEST || in_policy == OVERFLOW_BLOCK;
+    }
+    // -------------------------------------------------------------------------
+    // make_room_locked (m_event_queue_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    // [Note] returns false when io_record was consumed by the overflow policy
+    // (dropped, or stored in place of a pending event of the same source)
+    //
+    bool make_room_locked(std::unique_lock<std::mutex> &io_lock, EventRecord *io_record)
+    {
+      size_t capacity = m_capacity.load(std::memory_order_relaxed);
+      if (capacity == 0 || m_list_num.load(std::memory_order_relaxed) < capacity)
+        return true;
+      bool coalescing = m_coalescing.load(std::memory_order_relaxed);
+      if (coalescing)
       {
-        spin->m_spin->set_digits(update->m_digits);
-        return;
+        // The event replaces a pending one anyway (does not grow the queue)
+        auto it = m_coalesce_map.find(EventKey(*io_record));
+        if (it != m_coalesce_map.end() && it->second.m_record != nullptr)
+          return true;
       }
-      if (update->m_wrap_updated)
+      switch (m_overflow_policy.load(std::memory_order_relaxed))
       {
-        spin->m_spin->set_wrap(update->m_wrap);
-        return;
+        case OVERFLOW_BLOCK:
+          m_blocked_num.fetch_add(1, std::memory_order_relaxed);
+          m_space_waiter_num++;
+          m_space_cond.wait(io_lock, [this]
+          {
+            size_t num = m_capacity.load(std::memory_order_relaxed);
+            return num == 0 || m_list_num.load(std::memory_order_relaxed) < num;
+          });
+          m_space_waiter_num--;
+          return true;
+        case OVERFLOW_COALESCE_SOURCE:
+          for (auto it = m_event_data_queue.rbegin(); it != m_event_data_queue.rend(); it++)
+          {
+            if (EventKey(*it) == EventKey(*io_record))
+            {
+              release_record(&(*it));
+              (*it) = *io_record;
+              m_overflow_coalesced_num.fetch_add(1, std::memory_order_relaxed);
+              return false;
+            }
+          }
+          // Nothing to coalesce with, the oldest event is dropped instead
+          // fall through
+        case OVERFLOW_DROP_OLDEST:
+        {
+          EventRecord &record = m_event_data_queue.front();
+          if (coalescing)
+            release_coalesce_slot_locked(record);
+          release_record(&record);
+          recycle_node_locked(m_event_data_queue.begin());
+          m_dropped_num.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        default:  // OVERFLOW_DROP_NEWEST
+          release_record(io_record);
+          m_dropped_num.fetch_add(1, std::memory_order_relaxed);
+          return false;
       }
-      if (update->m_numeric_updated)
+    }
+    // -------------------------------------------------------------------------
+    // push_back_locked (m_event_queue_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    // [Note] list nodes are recycled through m_free_nodes (splice does not
+    // allocate), so the list backend does not allocate in the steady state
+    //
+    std::list<EventRecord>::iterator push_back_locked(const EventRecord &in_record)
+    {
+      m_list_num.fetch_add(1, std::memory_order_relaxed);
+      if (m_free_nodes.empty())
+        return m_event_data_queue.insert(m_event_data_queue.end(), in_record);
+      m_event_data_queue.splice(m_event_data_queue.end(),
+                                m_free_nodes, m_free_nodes.begin());
+      auto it = std::prev(m_event_data_queue.end());
+      (*it) = in_record;
+      return it;
+    }
+    // -------------------------------------------------------------------------
+    // recycle_node_locked (m_event_queue_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    void recycle_node_locked(std::list<EventRecord>::iterator in_it)
+    {
+      m_list_num.fetch_sub(1, std::memory_order_relaxed);
+      m_free_nodes.splice(m_free_nodes.end(), m_event_data_queue, in_it);
+      if (m_space_waiter_num != 0)
+        m_space_cond.notify_all();
+    }
+    // -------------------------------------------------------------------------
+    // move_list_to_batch_locked (m_event_queue_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    void move_list_to_batch_locked()
+    {
+      bool coalescing = m_coalescing.load(std::memory_order_relaxed);
+      for (auto it = m_event_data_queue.begin(); it != m_event_data_queue.end(); it++)
       {
-        spin->m_spin->set_numeric(update->m_numeric);
-        return;
+        if (coalescing)
+          release_coalesce_slot_locked(*it);
+        add_to_batch(*it);
       }
+      m_free_nodes.splice(m_free_nodes.end(), m_event_data_queue);
+      m_list_num.store(0, std::memory_order_relaxed);
+      if (m_space_waiter_num != 0)
+        m_space_cond.notify_all();
     }
-
-  private:
-    Gtk::SpinButton *m_spin;
-    SpinButtonUpdate  m_initial;
-
-    double m_value;
-    std::mutex  m_value_mutex;
-
-    double *m_user_variable;
-    void *m_user_data;
-    void (*m_value_changed_func)(void *, double);
-
-    friend class WindowData;
-    friend class WindowView;
-  };
-
-  // ===========================================================================
-  //  SwitchEvent class
-  // ===========================================================================
-  class SwitchEvent : public base::EventData
-  {
-  protected:
-      // member variables --------------------------------------------------------
-      bool m_value;
-
-      // -------------------------------------------------------------------------
-      // SwitchEvent constructor
-      // -------------------------------------------------------------------------
-      SwitchEvent(bool in_value,
-                  WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          base::EventData(in_source_widget, in_handler),
-          m_value(in_value)
+    // -------------------------------------------------------------------------
+    // process_events_impl
+    // -------------------------------------------------------------------------
+    size_t process_events_impl(bool in_last_only,
+                               size_t in_max_count,
+                               std::chrono::steady_clock::time_point in_deadline,
+                               bool in_try)
+    {
+      EventRing *ring = m_ring.load(std::memory_order_acquire);
+      if (ring != nullptr ||
+          m_swap_drain.load(std::memory_order_relaxed) ||
+          m_lane_mode.load(std::memory_order_relaxed) != LANE_MODE_FIFO ||
+          m_carry_num.load(std::memory_order_relaxed) != 0)
       {
+        std::unique_lock<std::mutex> consumer_lock(m_consumer_mutex, std::defer_lock);
+        if (in_try == false)
+          consumer_lock.lock();
+        else if (consumer_lock.try_lock() == false)
+          return size();
+        process_batch(ring, in_last_only, in_max_count, in_deadline, in_try);
+        consumer_lock.unlock();
+        clear_event_fd();
+        resume_deferred();
+        return size();
       }
-      // -------------------------------------------------------------------------
-      // SwitchEvent destructor
-      // -------------------------------------------------------------------------
-      ~SwitchEvent() override = default;
-
-      friend class SwitchData;
-  };
-
-  // ===========================================================================
-  //  SwitchUpdate class
-  // ===========================================================================
-  class SwitchUpdate : public base::EventData
-  {
-  protected:
-      // member variables --------------------------------------------------------
-      bool m_value_updated;
-      bool m_value;
-
-      // -------------------------------------------------------------------------
-      // SwitchUpdate constructor
-      // -------------------------------------------------------------------------
-      SwitchUpdate(bool in_value,
-                   WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          m_value(in_value),
-          m_value_updated(true),
-          base::EventData(in_source_widget, in_handler)
+      std::unique_lock<std::mutex> lock(m_event_queue_mutex, std::defer_lock);
+      if (in_try == false)
+        lock.lock();
+      else if (lock.try_lock() == false)
+        return size();
+      bool coalescing = m_coalescing.load(std::memory_order_relaxed);
+      bool check_time = (in_deadline != std::chrono::steady_clock::time_point::max());
+      size_t count = 0;
+      while (m_event_data_queue.empty() == false)
       {
+        if (count >= in_max_count ||
+            (check_time && std::chrono::steady_clock::now() >= in_deadline))
+          break;
+        bool skip = false;
+        EventRecord &record = m_event_data_queue.front();
+        if (coalescing)
+          release_coalesce_slot_locked(record);
+        else if (in_last_only)
+        {
+          EventKey key(record);
+          auto it = m_event_data_queue.begin();
+          it++;
+          while (it != m_event_data_queue.end())
+          {
+            if (EventKey(*it) == key)
+            {
+              skip = true;
+              break;
+            }
+            it++;
+          }
+        }
+        if (skip == false)
+        {
+          dispatch(record);
+          count++;
+        }
+        release_record(&record);
+        recycle_node_locked(m_event_data_queue.begin());
       }
-      // -------------------------------------------------------------------------
-      // SwitchUpdate destructor
-      // -------------------------------------------------------------------------
-      ~SwitchUpdate() override = default;
-
-      friend class SwitchData;
-  };
-
-  // ===========================================================================
-  //  SwitchData class (GtkSwitch)
-  // ===========================================================================
-  class SwitchData : public WidgetData
-  {
-  public:
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // get_value
-      // -------------------------------------------------------------------------
-      bool get_value(bool *io_value, bool in_compare = false)
+      lock.unlock();
+      clear_event_fd();
+      resume_deferred();
+      return size();
+    }
+    // -------------------------------------------------------------------------
+    // process_batch (m_consumer_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    // [Note] the pending events are moved out of the queue (under
+    // m_event_queue_mutex for the list, lock-free for the ring) and the
+    // handlers are invoked without holding m_event_queue_mutex.
+    // In the FIFO lane mode, the rest of an interrupted batch is finished
+    // before gathering new events (keeps the order). In the other modes new
+    // events are always gathered first, so that a higher priority event does
+    // not wait behind the rest of a lower priority batch
+    //
+    void process_batch(EventRing *in_ring,
+                       bool in_last_only,
+                       size_t in_max_count,
+                       std::chrono::steady_clock::time_point in_deadline,
+                       bool in_try)
+    {
+      size_t count = 0;
+      bool gathered = false;
+      if (m_coalescing.load(std::memory_order_relaxed))
+        in_last_only = false; // already one event per source after gathering
+      if (m_lane_mode.load(std::memory_order_relaxed) != LANE_MODE_FIFO ||
+          m_carry_num.load(std::memory_order_relaxed) == 0)
       {
-        if (io_value == nullptr)
-          return false;
-        std::lock_guard<std::mutex> lock(m_value_mutex);
-        if (in_compare)
-          if (*io_value == m_value)
-            return false;
-        *io_value = m_value;
-        return true;
+        gather_batch(in_ring, in_try);
+        gathered = true;
       }
-      // -------------------------------------------------------------------------
-      // set_value
-      // -------------------------------------------------------------------------
-      void set_value(bool in_value, bool in_invoke_update = true)
+      for (;;)
       {
-        if (m_switch == nullptr)
+        if (invoke_batch(in_last_only, in_max_count, in_deadline, &count) == false)
+          break;
+        if (gathered)
+          break;
+        gathered = true;
+        gather_batch(in_ring, in_try);
+      }
+      size_t carry_num = 0;
+      for (size_t i = 0; i < EVENT_PRIORITY_NUM; i++)
+      {
+        LaneBatch &batch = m_lanes[i];
+        if (batch.m_pos >= batch.m_events.size())
         {
-          m_initial.m_value = in_value;
-          return;
+          batch.m_events.clear();
+          batch.m_pos = 0;
         }
-        auto *update = new SwitchUpdate(in_value, this, process_update);
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
+        else if (batch.m_pos > batch.m_events.size() / 2)
+        {
+          batch.m_events.erase(batch.m_events.begin(),
+                               batch.m_events.begin() + (ptrdiff_t)batch.m_pos);
+          batch.m_pos = 0;
+        }
+        carry_num += batch.m_events.size() - batch.m_pos;
       }
-
-  protected:
-      // -------------------------------------------------------------------------
-      // SwitchData destructor
-      // -------------------------------------------------------------------------
-      ~SwitchData() override
+      m_carry_num.store(carry_num, std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    // add_to_batch (m_consumer_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    void add_to_batch(const EventRecord &in_record)
+    {
+      size_t lane = 0;
+      if (m_lane_mode.load(std::memory_order_relaxed) != LANE_MODE_FIFO)
+        lane = std::min<size_t>(in_record.m_priority, EVENT_PRIORITY_NUM - 1);
+      m_lanes[lane].m_events.push_back(in_record);
+    }
+    // -------------------------------------------------------------------------
+    // gather_batch (m_consumer_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    void gather_batch(EventRing *in_ring, bool in_try)
+    {
+      std::unique_lock<std::mutex> lock(m_event_queue_mutex, std::defer_lock);
+      if (in_ring == nullptr)
       {
-        delete m_switch;
+        if (in_try == false)
+          lock.lock();
+        else if (lock.try_lock() == false)
+          return;
+        move_list_to_batch_locked();
+        return;
       }
-
-      // -------------------------------------------------------------------------
-      // SwitchData constructor
-      // -------------------------------------------------------------------------
-      SwitchData(base::WindowBase *in_window,
-                 const char *in_label_str,
-                 bool *in_user_variable,
-                 void *in_user_data = nullptr,
-                 void (*in_toggled_func)(void *in_user_data) = nullptr,
-                 base::EventQueue *in_user_event_queue = nullptr) :
-          WidgetData(in_window, in_label_str, in_user_event_queue),
-          m_user_variable(in_user_variable),
-          m_initial(false, nullptr, nullptr),
-          m_user_data(in_user_data),
-          m_toggled_func(in_toggled_func),
-          m_switch(nullptr), m_value(false)
+      size_t start[EVENT_PRIORITY_NUM];
+      for (size_t i = 0; i < EVENT_PRIORITY_NUM; i++)
+        start[i] = m_lanes[i].m_events.size();
+      EventRecord record;
+      while (in_ring->pop(&record))
+        add_to_batch(record);
+      if (m_overflow_num.load(std::memory_order_acquire) != 0)
       {
-        if (in_user_variable != nullptr)
-          m_initial.m_value = *in_user_variable;
+        if (in_try == false)
+          lock.lock();
+        if (lock.owns_lock() || lock.try_lock())
+        {
+          while (in_ring->pop(&record))
+            add_to_batch(record);
+          move_list_to_batch_locked();
+          m_overflow_num.store(0, std::memory_order_release);
+          lock.unlock();
+        }
       }
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // create
-      // -------------------------------------------------------------------------
-      Gtk::Box *create() override
+      if (m_coalescing.load(std::memory_order_relaxed))
       {
-        Gtk::Box  *box = WidgetData::create();
-        if (box == nullptr)
-          return nullptr;
-        if (m_user_variable != nullptr)
-          *m_user_variable = m_initial.m_value;
-        m_value = m_initial.m_value;
-        m_switch = new Gtk::Switch();
-        if (m_switch == nullptr)
-          return nullptr;
-        m_switch->set_active(m_value);
-        m_switch->signal_state_set().connect(
-            sigc::mem_fun(*this, &SwitchData::queue_state_set));
-        box->pack_end(*m_switch, Gtk::PACK_SHRINK);
-        return box;
+        // One backward pass: keep the last event of each (source, handler)
+        for (size_t i = 0; i < EVENT_PRIORITY_NUM; i++)
+        {
+          std::vector<EventRecord> &events = m_lanes[i].m_events;
+          m_seen_keys.clear();
+          for (size_t j = events.size(); j > start[i]; j--)
+          {
+            if (m_seen_keys.insert(EventKey(events[j - 1])).second)
+              continue;
+            release_record(&events[j - 1]);
+            m_coalesced_num.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
       }
-      // -------------------------------------------------------------------------
-      // queue_state_set
-      // -------------------------------------------------------------------------
-      bool queue_state_set(bool inState)
+    }
+    // -------------------------------------------------------------------------
+    // select_lane (m_consumer_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    // [Note] returns -1 if all lanes are empty
+    //
+    int select_lane()
+    {
+      for (size_t i = 0; i < EVENT_PRIORITY_NUM; i++)
       {
-        std::lock_guard<std::mutex> lock(m_value_mutex);
-        m_value = inState;
-        mark_as_updated();
-        if (m_toggled_func == nullptr && m_user_variable == nullptr)
-          return false;
-        auto *event = new SwitchEvent(
-            m_value,
-            this, process_state_set);
-        push_event(event);
-        return false;
+        LaneBatch &batch = m_lanes[i];
+        while (batch.m_pos < batch.m_events.size() &&
+               batch.m_events[batch.m_pos].m_opcode == EVENT_OPCODE_NONE)
+          batch.m_pos++;
       }
-      // -------------------------------------------------------------------------
-      // process_state_set
-      // -------------------------------------------------------------------------
-      static void process_state_set(base::EventData *in_event)
+      if (m_lane_mode.load(std::memory_order_relaxed) != LANE_MODE_WEIGHTED)
       {
-        auto *event = (SwitchEvent *)in_event;
-        auto  *button = (SwitchData *)event->get_source();
-        if (button->m_user_variable != nullptr)
-          *(button->m_user_variable) = event->m_value;
-        if (button->m_toggled_func != nullptr)
-          button->m_toggled_func(button->m_user_data);
+        for (size_t i = 0; i < EVENT_PRIORITY_NUM; i++)
+          if (m_lanes[i].m_pos < m_lanes[i].m_events.size())
+            return (int)i;
+        return -1;
       }
-      // -------------------------------------------------------------------------
-      // process_update
-      // -------------------------------------------------------------------------
-      static void process_update(base::EventData *in_update)
+      // Weighted round robin: up to "weight" events from a lane, then the next
+      for (size_t n = 0; n <= EVENT_PRIORITY_NUM; n++)
       {
-        auto *update = (SwitchUpdate *) in_update;
-        auto *button = (SwitchData *) update->get_source();
-
-        if (update->m_value_updated)
+        LaneBatch &batch = m_lanes[m_lane_cursor];
+        if (batch.m_pos < batch.m_events.size() && m_lane_credit > 0)
         {
-          button->m_switch->set_active(update->m_value);
-          return;
+          m_lane_credit--;
+          return (int)m_lane_cursor;
         }
+        m_lane_cursor = (m_lane_cursor + 1) % EVENT_PRIORITY_NUM;
+        m_lane_credit = m_lane_weight[m_lane_cursor].load(std::memory_order_relaxed);
       }
+      return -1;
+    }
+    // -------------------------------------------------------------------------
+    // invoke_batch (m_consumer_mutex needs to be locked)
+    // -------------------------------------------------------------------------
+    // [Note] returns false when the budget ran out before the end of the batch
+    //
+    bool invoke_batch(bool in_last_only,
+                      size_t in_max_count,
+                      std::chrono::steady_clock::time_point in_deadline,
+                      size_t *io_count)
+    {
+      bool check_time = (in_deadline != std::chrono::steady_clock::time_point::max());
+      for (;;)
+      {
+        int lane = select_lane();
+        if (lane < 0)
+          return true;
+        if (*io_count >= in_max_count ||
+            (check_time && std::chrono::steady_clock::now() >= in_deadline))
+        {
+          if (m_lane_credit < UINT_MAX)
+            m_lane_credit++;  // give back the credit taken by select_lane()
+          return false;
+        }
+        LaneBatch &batch = m_lanes[lane];
+        EventRecord record = batch.m_events[batch.m_pos];
+        bool skip = false;
+        if (in_last_only)
+        {
+          EventKey key(record);
+          for (size_t i = batch.m_pos + 1; i < batch.m_events.size(); i++)
+          {
+            if (batch.m_events[i].m_opcode != EVENT_OPCODE_NONE &&
+                EventKey(batch.m_events[i]) == key)
+            {
+              skip = true;
+              break;
+            }
+          }
+        }
+        batch.m_events[batch.m_pos].m_opcode = EVENT_OPCODE_NONE;
+        batch.m_pos++;
+        if (skip == false)
+        {
+          dispatch(record);
+          (*io_count)++;
+        }
+        release_record(&record);
+      }
+    }
 
-  private:
-      // member variables --------------------------------------------------------
-      Gtk::Switch *m_switch;
-      SwitchUpdate  m_initial;
-
-      bool m_value;
-      std::mutex  m_value_mutex;
+    // static functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // make_record
+    // -------------------------------------------------------------------------
+    static EventRecord make_record(void *in_source, void (*in_handler)(),
+                                   EventOpcode in_opcode,
+                                   EventPriority in_priority)
+    {
+      EventRecord record;
+      record.m_source = in_source;
+      record.m_handler = in_handler;
+      record.m_enqueue_ns = 0;
+      record.m_opcode = (unsigned char)in_opcode;
+      record.m_priority = (unsigned char)in_priority;
+      record.m_payload.m_int = 0;
+      return record;
+    }
+    // -------------------------------------------------------------------------
+    // release_record
+    // -------------------------------------------------------------------------
+    // [Note] frees the boxed EventData (if any) and marks the record empty
+    //
+    static void release_record(EventRecord *io_record)
+    {
+      if (io_record->m_opcode == EVENT_OPCODE_BOXED)
+        delete io_record->m_payload.m_boxed;
+      io_record->m_opcode = EVENT_OPCODE_NONE;
+    }
+    // -------------------------------------------------------------------------
+    // now_ns
+    // -------------------------------------------------------------------------
+    static int64_t now_ns()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    // -------------------------------------------------------------------------
+    // to_deadline
+    // -------------------------------------------------------------------------
+    static std::chrono::steady_clock::time_point to_deadline(
+                            std::chrono::steady_clock::duration in_timeout)
+    {
+      auto now = std::chrono::steady_clock::now();
+      if (in_timeout >= std::chrono::steady_clock::time_point::max() - now)
+        return std::chrono::steady_clock::time_point::max();
+      return now + in_timeout;
+    }
 
-      bool *m_user_variable;
-      void *m_user_data;
-      void (*m_toggled_func)(void *in_user_data);
+  private:
+    // member types ------------------------------------------------------------
+    struct EventKey
+    {
+      explicit EventKey(const EventRecord &in_record) :
+          m_source(in_record.m_source),
+          m_handler(in_record.m_handler)
+      {
+      }
+      bool operator==(const EventKey &in_key) const
+      {
+        return m_source == in_key.m_source && m_handler == in_key.m_handler;
+      }
+      void  *m_source;
+      void (*m_handler)();
+    };
+    struct EventKeyHash
+    {
+      size_t operator()(const EventKey &in_key) const
+      {
+        auto source = (size_t)(uintptr_t)in_key.m_source;
+        auto handler = (size_t)(uintptr_t)in_key.m_handler;
+        return source ^ (handler + 0x9e3779b9 + (source << 6) + (source >> 2));
+      }
+    };
+    struct CoalesceSlot
+    {
+      EventRecord *m_record = nullptr;
+      std::list<EventRecord>::iterator m_it;
+    };
+    struct LaneBatch
+    {
+      std::vector<EventRecord> m_events;
+      size_t m_pos = 0;
+    };
 
-      friend class WindowData;
-      friend class WindowView;
+    // member variables --------------------------------------------------------
+    std::list<EventRecord>  m_event_data_queue;
+    std::list<EventRecord>  m_free_nodes;
+    std::condition_variable m_new_event_cond;
+    std::mutex  m_event_queue_mutex;
+    //
+    std::atomic<EventRing *>  m_ring;
+    std::atomic<size_t> m_overflow_num;
+    std::atomic<int>    m_waiter_num;
+    std::mutex  m_consumer_mutex;
+    LaneBatch m_lanes[EVENT_PRIORITY_NUM];
+    std::atomic<size_t> m_carry_num;
+    std::atomic<size_t> m_list_num;
+    //
+    std::atomic<bool>   m_coalescing;
+    std::atomic<size_t> m_coalesced_num;
+    std::unordered_map<EventKey, CoalesceSlot, EventKeyHash>  m_coalesce_map;
+    std::unordered_set<EventKey, EventKeyHash>  m_seen_keys;
+    std::atomic<bool>   m_swap_drain;
+    //
+    std::atomic<int>    m_event_fd;
+    std::atomic<bool>   m_event_fd_signaled;
+    //
+    std::atomic<LaneMode> m_lane_mode;
+    std::atomic<unsigned> m_lane_weight[EVENT_PRIORITY_NUM];
+    size_t    m_lane_cursor;
+    unsigned  m_lane_credit;
+    //
+    std::atomic<size_t> m_capacity;
+    std::atomic<OverflowPolicy> m_overflow_policy;
+    std::condition_variable m_space_cond;
+    size_t  m_space_waiter_num;
+    std::atomic<size_t> m_dropped_num;
+    std::atomic<size_t> m_overflow_coalesced_num;
+    std::atomic<size_t> m_blocked_num;
+    //
+    std::atomic<bool>   m_stats_enabled;
+    std::atomic<size_t> m_peak_depth;
+    std::atomic<size_t> m_enqueue_num;
+    std::atomic<size_t> m_dispatch_num;
+    std::atomic<int64_t>  m_stats_start_ns;
+    std::vector<LatencyHistogram> m_latency;
+    std::unordered_map<void (*)(), size_t> m_latency_index; // handler -> m_latency
+    std::mutex  m_stats_mutex;
+#ifdef SHL_GTK_COROUTINE
+    //
+    AwaiterList<bool> m_awaiters;
+    std::vector<std::coroutine_handle<>> m_deferred; // see defer_resume()
+    std::atomic<size_t> m_deferred_num;
+    std::mutex  m_deferred_mutex;
+#endif
+    //
+    EventPool m_event_pool;
   };
 
+#ifdef SHL_GTK_COROUTINE
   // ===========================================================================
-  //  ComboBoxEvent class
+  //  EventQueueExecutor class
   // ===========================================================================
-  class ComboBoxEvent : public base::EventData
+  // Resumes the coroutines from EventQueue::process_events() of the queue,
+  // i.e. on the thread that drains it. One thread can serve any number of
+  // coroutines (and windows) this way.
+  // The coroutine is resumed after the queue locks are released (see
+  // EventQueue::defer_resume), so it may call process_events() again,
+  // co_await next_event() or push to the same queue
+  //
+  class EventQueueExecutor : public Executor
   {
-  protected:
-      // member variables --------------------------------------------------------
-      int m_value;
-
-      // -------------------------------------------------------------------------
-      // ComboBoxEvent constructor
-      // -------------------------------------------------------------------------
-      ComboBoxEvent(int in_value,
-                    WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          base::EventData(in_source_widget, in_handler),
-          m_value(in_value)
-      {
-      }
-      // -------------------------------------------------------------------------
-      // ComboBoxEvent destructor
-      // -------------------------------------------------------------------------
-      ~ComboBoxEvent() override = default;
-
-      friend class ComboBoxData;
-  };
-
-  // ===========================================================================
-  //  ComboBoxUpdate class
-  // ===========================================================================
-  class ComboBoxUpdate : public base::EventData
-  {
-  protected:
-      // member variables --------------------------------------------------------
-      bool m_value_updated;
-      int m_value;
-
-      // -------------------------------------------------------------------------
-      // ComboBoxUpdate constructor
-      // -------------------------------------------------------------------------
-      ComboBoxUpdate(int in_value,
-                     WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          m_value(in_value),
-          m_value_updated(true),
-          base::EventData(in_source_widget, in_handler)
-      {
-      }
-      // -------------------------------------------------------------------------
-      // ComboBoxUpdate destructor
-      // -------------------------------------------------------------------------
-      ~ComboBoxUpdate() override = default;
+  public:
+    explicit EventQueueExecutor(EventQueue *in_queue) :
+        m_queue(in_queue)
+    {
+    }
+    // [Note] not pushed as an event, so the overflow policy of the queue
+    // can never drop a resume (the coroutine would leak)
+    //
+    void post(std::coroutine_handle<> in_handle) override
+    {
+      m_queue->defer_resume(in_handle);
+    }
 
-      friend class ComboBoxData;
+  private:
+    EventQueue  *m_queue;
   };
+#endif
 
   // ===========================================================================
-  //  ComboBoxData class (GtkComboBox)
+  //  TimerData class
   // ===========================================================================
-  class ComboBoxData : public WidgetData
+  class TimerData
   {
-  public:
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // get_value
-      // -------------------------------------------------------------------------
-      bool get_value(int *io_value, bool in_compare = false)
-      {
-        if (io_value == nullptr)
-          return false;
-        std::lock_guard<std::mutex> lock(m_value_mutex);
-        if (in_compare)
-          if (*io_value == m_value)
-            return false;
-        *io_value = m_value;
-        return true;
-      }
-      // -------------------------------------------------------------------------
-      // set_value
-      // -------------------------------------------------------------------------
-      void set_value(int in_value, bool in_invoke_update = true)
-      {
-        if (m_combo_box == nullptr)
-        {
-          m_initial.m_value = in_value;
-          return;
-        }
-        auto *update = new ComboBoxUpdate(in_value, this, process_update);
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
-      }
-
   protected:
-      // -------------------------------------------------------------------------
-      // ComboBoxData destructor
-      // -------------------------------------------------------------------------
-      ~ComboBoxData() override
-      {
-        delete m_combo_box;
-      }
-
-      // -------------------------------------------------------------------------
-      // ComboBoxData constructor
-      // -------------------------------------------------------------------------
-      ComboBoxData(base::WindowBase *in_window,
-                   const char *in_label_str,
-                   const std::vector<std::string> &in_items,
-                   int *in_user_variable,
-                   void *in_user_data = nullptr,
-                   void (*in_changed_func)(void *in_user_data) = nullptr,
-                   base::EventQueue *in_user_event_queue = nullptr) :
-          WidgetData(in_window, in_label_str, in_user_event_queue),
-          m_user_variable(in_user_variable),
-          m_items(in_items),
-          m_initial(0, nullptr, nullptr),
-          m_user_data(in_user_data),
-          m_changed_func(in_changed_func),
-          m_combo_box(nullptr), m_value(0)
-      {
-        if (in_user_variable != nullptr)
-          m_initial.m_value = *in_user_variable;
-      }
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // create
-      // -------------------------------------------------------------------------
-      Gtk::Box *create() override
-      {
-        Gtk::Box  *box = WidgetData::create();
-        if (box == nullptr)
-          return nullptr;
-        if (m_user_variable != nullptr)
-          *m_user_variable = m_initial.m_value;
-        m_value = m_initial.m_value;
-        m_combo_box = new Gtk::ComboBoxText();
-        if (m_combo_box == nullptr)
-          return nullptr;
-        for (auto it = m_items.begin(); it != m_items.end(); it++)
-          m_combo_box->append((*it));
-        m_combo_box->set_active(m_value);
-        m_combo_box->signal_changed().connect(
-            sigc::mem_fun(*this, &ComboBoxData::queue_changed));
-        box->pack_end(*m_combo_box, Gtk::PACK_SHRINK);
-        return box;
-      }
-      // -------------------------------------------------------------------------
-      // queue_changed
-      // -------------------------------------------------------------------------
-      void queue_changed()
-      {
-        std::lock_guard<std::mutex> lock(m_value_mutex);
-        m_value = m_combo_box->get_active_row_number();
-        mark_as_updated();
-        if (m_changed_func == nullptr && m_user_variable == nullptr)
-          return;
-        auto *event = new ComboBoxEvent(
-            m_value,
-            this, process_changed);
-        push_event(event);
-      }
-      // -------------------------------------------------------------------------
-      // process_changed
-      // -------------------------------------------------------------------------
-      static void process_changed(base::EventData *in_event)
-      {
-        auto *event = (ComboBoxEvent *)in_event;
-        auto  *button = (ComboBoxData *)event->get_source();
-        if (button->m_user_variable != nullptr)
-          *(button->m_user_variable) = event->m_value;
-        if (button->m_changed_func != nullptr)
-          button->m_changed_func(button->m_user_data);
-      }
-      // -------------------------------------------------------------------------
-      // process_update
-      // -------------------------------------------------------------------------
-      static void process_update(base::EventData *in_update)
-      {
-        auto *update = (ComboBoxUpdate *) in_update;
-        auto *button = (ComboBoxData *) update->get_source();
+    // -------------------------------------------------------------------------
+    // TimerData constructor
+    // -------------------------------------------------------------------------
+    TimerData( unsigned int in_interval_ms,
+                EventQueue *in_user_event_queue,
+                void (*in_timer_event_func)(void *in_user_data),
+                void *in_user_data = nullptr) :
+        m_interval_ms(in_interval_ms),
+        m_user_event_queue(in_user_event_queue),
+        m_timer_event_func(in_timer_event_func),
+        m_user_data(in_user_data),
+        m_is_running(false)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // WidgetData destructor
+    // -------------------------------------------------------------------------
+    virtual ~TimerData() = default;
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // connect (needs to be called from the UI thread)
+    // -------------------------------------------------------------------------
+    void connect()
+    {
+      mTimerConnection = Glib::signal_timeout().connect(
+              sigc::mem_fun(*this, &TimerData::queue_timer_event), m_interval_ms);
+      m_is_running = true;
+      // todo : add connect_seconds() path also
+    }
+    // -------------------------------------------------------------------------
+    // disconnect (needs to be called from the UI thread)
+    // -------------------------------------------------------------------------
+    void disconnect()
+    {
+      if (m_is_running == false)
+        return;
+      mTimerConnection.disconnect();
+      m_is_running = false;
+    }
+    // -------------------------------------------------------------------------
+    // queue_timer_event
+    // -------------------------------------------------------------------------
+    bool queue_timer_event()
+    {
+      if (m_user_event_queue == nullptr || m_timer_event_func == nullptr)
+        return false; // return false = disconnect
 
-        if (update->m_value_updated)
-        {
-          button->m_combo_box->set_active(update->m_value);
-          return;
-        }
-      }
+      m_user_event_queue->push(this, process_timer_event, EVENT_PRIORITY_HIGH);
+      return true;  
+    }
+    // -------------------------------------------------------------------------
+    // process_timer_event
+    // -------------------------------------------------------------------------
+    static void process_timer_event(base::EventData *in_event)
+    {
+      auto  *timer = (TimerData *)in_event->get_source();
+      timer->m_timer_event_func(timer->m_user_data);
+    }
 
   private:
-      // member variables --------------------------------------------------------
-      Gtk::ComboBoxText *m_combo_box;
-      ComboBoxUpdate  m_initial;
-
-      int m_value;
-      std::mutex  m_value_mutex;
-      std::vector<std::string>  m_items;
-
-      int *m_user_variable;
-      void *m_user_data;
-      void (*m_changed_func)(void *in_user_data);
+    // member variables --------------------------------------------------------
+    unsigned int  m_interval_ms;
+    void (*m_timer_event_func)(void *in_user_data);
+    void *m_user_data;
+    EventQueue *m_user_event_queue;
+    sigc::connection  mTimerConnection;
+    bool  m_is_running;
 
-      friend class WindowData;
-      friend class WindowView;
+    friend class BackgroundApp;
+    friend class WindowBase;
   };
 
   // ===========================================================================
-  //  ScaleEvent class
+  //  AppCommand struct
   // ===========================================================================
-  class ScaleEvent : public base::EventData
+  enum AppCommandType
   {
-  protected:
-      // member variables --------------------------------------------------------
-      double m_value;
-
-      // -------------------------------------------------------------------------
-      // ScaleEvent constructor
-      // -------------------------------------------------------------------------
-      ScaleEvent(double in_value,
-                 WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          base::EventData(in_source_widget, in_handler),
-          m_value(in_value)
-      {
-      }
-      // -------------------------------------------------------------------------
-      // ScaleEvent destructor
-      // -------------------------------------------------------------------------
-      ~ScaleEvent() override = default;
-
-      friend class ScaleData;
+    APP_COMMAND_CREATE_WINDOW = 0,
+    APP_COMMAND_DELETE_WINDOW,
+    APP_COMMAND_UPDATE_WINDOW,
+    APP_COMMAND_CONNECT_TIMER,
+    APP_COMMAND_DISCONNECT_TIMER,
+    APP_COMMAND_QUIT
+  };
+  struct AppCommand
+  {
+    AppCommandType m_type;
+    BackgroundAppWindowInterface *m_interface;
+    TimerData   *m_timer;
+    const char  *m_title;
   };
 
   // ===========================================================================
-  //  ScaleUpdate class
+  //  BackgroundApp class
   // ===========================================================================
-  class ScaleUpdate : public base::EventData
+  class BackgroundApp : public Gtk::Application
   {
-  protected:
-      // member variables --------------------------------------------------------
-      bool m_value_updated;
-      bool m_range_updated, m_increments_updated;
-      bool m_digits_updated;
-      bool m_adjustment_called; // value, lower, upper, step, page, page_size
-      //
-      double m_value;
-      double m_lower, m_upper;
-      double m_step_increment, m_page_increment;
-      double m_page_size;
-      int m_digits;
+  public:
+    // -------------------------------------------------------------------------
+    // BackgroundApp destructor
+    // -------------------------------------------------------------------------
+    ~BackgroundApp() override
+    {
+      SHL_DBG_OUT("BackgroundApp was deleted");
+    }
 
-      // -------------------------------------------------------------------------
-      // ScaleUpdate constructor
-      // -------------------------------------------------------------------------
-      ScaleUpdate(double in_value,
-                  double in_lower, double in_upper,
-                  double in_step_increment,
-                  double in_page_increment,
-                  double in_page_size,
-                  int in_digits) :
-          m_value(in_value),
-          m_lower(in_lower), m_upper(in_upper),
-          m_step_increment(in_step_increment), m_page_increment(in_page_increment),
-          m_page_size(in_page_size),
-          m_digits(in_digits),
-          m_value_updated(true),
-          m_range_updated(true), m_increments_updated(true),
-          m_digits_updated(true),
-          m_adjustment_called(true),
-          base::EventData(nullptr, nullptr)
+  protected:
+    // -------------------------------------------------------------------------
+    // BackgroundApp constructor
+    // -------------------------------------------------------------------------
+    BackgroundApp() :
+            Gtk::Application("org.gtkmm.examples.application",
+                             Gio::APPLICATION_NON_UNIQUE),
+                             m_wakeup_scheduled(false)
+    {
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // post_create_window
+    // -------------------------------------------------------------------------
+    // [Note] this function will be called from another thread
+    //
+    void post_create_window(BackgroundAppWindowInterface *in_interface, const char *in_title)
+    {
+      post_command(APP_COMMAND_CREATE_WINDOW, in_interface, nullptr, in_title);
+    }
+    // -------------------------------------------------------------------------
+    // post_delete_window
+    // -------------------------------------------------------------------------
+    // [Note] this function will be called from another thread
+    //
+    void post_delete_window(BackgroundAppWindowInterface *in_interface)
+    {
+      post_command(APP_COMMAND_DELETE_WINDOW, in_interface);
+    }
+    // -------------------------------------------------------------------------
+    // post_update_window
+    // -------------------------------------------------------------------------
+    // [Note] this function will be called from another thread
+    //
+    void post_update_window(BackgroundAppWindowInterface *in_interface)
+    {
+      post_command(APP_COMMAND_UPDATE_WINDOW, in_interface);
+    }
+    // -------------------------------------------------------------------------
+    // post_connect_timer
+    // -------------------------------------------------------------------------
+    // [Note] this function will be called from another thread
+    //
+    void post_connect_timer(TimerData *inTimerData)
+    {
+      post_command(APP_COMMAND_CONNECT_TIMER, nullptr, inTimerData);
+    }
+    // -------------------------------------------------------------------------
+    // post_disconnect_timer
+    // -------------------------------------------------------------------------
+    // [Note] this function will be called from another thread
+    //
+    void post_disconnect_timer(TimerData *inTimerData)
+    {
+      post_command(APP_COMMAND_DISCONNECT_TIMER, nullptr, inTimerData);
+    }
+    // -------------------------------------------------------------------------
+    // post_quit_app
+    // -------------------------------------------------------------------------
+    // [Note] this function will be called from another thread
+    //
+    void post_quit_app()
+    {
+      post_command(APP_COMMAND_QUIT);
+    }
+    // -------------------------------------------------------------------------
+    // post_command
+    // -------------------------------------------------------------------------
+    // All the post_*() functions end up here: one lock for the push, and at
+    // most one pending idle callback for any number of posts
+    //
+    void post_command(AppCommandType in_type,
+                      BackgroundAppWindowInterface *in_interface = nullptr,
+                      TimerData *in_timer = nullptr,
+                      const char *in_title = nullptr)
+    {
       {
+        std::lock_guard<std::mutex> lock(m_command_mutex);
+        m_command_queue.push_back({in_type, in_interface, in_timer, in_title});
       }
-      // -------------------------------------------------------------------------
-      // ScaleUpdate constructor
-      // -------------------------------------------------------------------------
-      ScaleUpdate(WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
-          m_value(0),
-          m_lower(0), m_upper(0),
-          m_step_increment(1), m_page_increment(10),
-          m_page_size(0),
-          m_digits(0),
-          m_value_updated(false),
-          m_range_updated(false), m_increments_updated(false),
-          m_digits_updated(false),
-          m_adjustment_called(false),
-          base::EventData(in_source_widget, in_handler)
+      if (m_wakeup_scheduled.exchange(true, std::memory_order_acq_rel))
+        return;
+      // Invoke one time on_idle call (by returning false from the signal handler)
+      Glib::signal_idle().connect(sigc::mem_fun(*this, &BackgroundApp::on_idle));
+    }
+    // -------------------------------------------------------------------------
+    // get_window_num
+    // -------------------------------------------------------------------------
+    size_t get_window_num()
+    {
+      return m_window_list.size();
+    }
+    // -------------------------------------------------------------------------
+    // wait_window_all_closed
+    // -------------------------------------------------------------------------
+    void wait_window_all_closed()
+    {
+      std::unique_lock<std::mutex> window_lock(m_window_mutex);
+      if (get_window_num() == 0)
+        return;
+      m_window_cond.wait(window_lock);
+    }
+    // -------------------------------------------------------------------------
+    // on_activate
+    // -------------------------------------------------------------------------
+    void on_activate() override
+    {
+      // The application has been started, so let's show a window.
+      process_commands();
+    }
+    // -------------------------------------------------------------------------
+    // on_delete_event
+    // -------------------------------------------------------------------------
+    bool on_delete_event(GdkEventAny *in_event)
+    {
+      for (auto it = m_window_list.begin(); it != m_window_list.end(); it++)
       {
+        //if (in_window == (*it)->back_app_get_window())
+        if (in_event->window == (*it)->back_app_get_window()->get_window()->gobj())
+          return (*it)->back_app_delete_request();
       }
-      // -------------------------------------------------------------------------
-      // ScaleUpdate destructor
-      // -------------------------------------------------------------------------
-      ~ScaleUpdate() override = default;
+      return false;
+    }
+    // -------------------------------------------------------------------------
+    // on_hide_window
+    // -------------------------------------------------------------------------
+    void on_hide_window(Gtk::Window *in_window)
+    {
+      for (auto it = m_window_list.begin(); it != m_window_list.end(); it++)
+      {
+        if (in_window == (*it)->back_app_get_window())
+        {
+          (*it)->back_app_delete_window();
+          m_window_list.erase(it);
+          break;
+        }
+      }
+      if (m_window_list.empty())
+        m_window_cond.notify_all();
+    }
+    // -------------------------------------------------------------------------
+    // on_idle
+    // -------------------------------------------------------------------------
+    bool on_idle()
+    {
+      SHL_DBG_OUT("on_idle() was called");
+      process_commands();
+      // by returning false here, this signal handler will be disconnected
+      // from Glib::signal_idle()
+      // https://gnome.pages.gitlab.gnome.org/gtkmm-documentation/sec-idle-functions.html
+      return false;
+    }
+    // -------------------------------------------------------------------------
+    // process_commands
+    // -------------------------------------------------------------------------
+    void process_commands()
+    {
+      // Clear the flag before taking the queue: a command posted after this
+      // point schedules a new idle callback
+      m_wakeup_scheduled.store(false, std::memory_order_release);
+      {
+        std::lock_guard<std::mutex> lock(m_command_mutex);
+        m_command_work.swap(m_command_queue);
+      }
+      bool quit_app = false;
+      for (auto it = m_command_work.begin(); it != m_command_work.end(); it++)
+      {
+        switch (it->m_type)
+        {
+          case APP_COMMAND_CREATE_WINDOW:
+            process_create_window(it->m_interface, it->m_title);
+            break;
+          case APP_COMMAND_DELETE_WINDOW:
+            process_delete_window(it->m_interface);
+            break;
+          case APP_COMMAND_UPDATE_WINDOW:
+            process_update_window(it->m_interface);
+            break;
+          case APP_COMMAND_CONNECT_TIMER:
+            it->m_timer->connect();
+            break;
+          case APP_COMMAND_DISCONNECT_TIMER:
+            it->m_timer->disconnect();
+            break;
+          case APP_COMMAND_QUIT:
+            quit_app = true;
+            break;
+        }
+      }
+      m_command_work.clear();
+      if (quit_app)
+        quit();
+    }
+    // -------------------------------------------------------------------------
+    // process_create_window
+    // -------------------------------------------------------------------------
+    void process_create_window(BackgroundAppWindowInterface *in_interface, const char *in_title)
+    {
+      auto it = std::find(m_window_list.begin(), m_window_list.end(), in_interface);
+      if (it != m_window_list.end())
+        return;
+      Gtk::Window *win = in_interface->back_app_create_window(in_title);
+      add_window(*win);
+      win->signal_delete_event().connect(sigc::mem_fun(*this,
+                        &BackgroundApp::on_delete_event));
+      win->signal_hide().connect(sigc::bind<Gtk::Window *>(
+              sigc::mem_fun(*this,
+                            &BackgroundApp::on_hide_window), win));
+      win->present();
+      m_window_list.push_back(in_interface);
+    }
+    // -------------------------------------------------------------------------
+    // process_delete_window
+    // -------------------------------------------------------------------------
+    void process_delete_window(BackgroundAppWindowInterface *in_interface)
+    {
+      auto it = std::find(m_window_list.begin(), m_window_list.end(), in_interface);
+      if (it == m_window_list.end())
+        return;
+      Gtk::Window *win = in_interface->back_app_get_window();
+      win->close();
+      remove_window(*win);
+      in_interface->back_app_delete_window();
+      m_window_list.erase(it);
+    }
+    // -------------------------------------------------------------------------
+    // process_update_window
+    // -------------------------------------------------------------------------
+    void process_update_window(BackgroundAppWindowInterface *in_interface)
+    {
+      auto it = std::find(m_window_list.begin(), m_window_list.end(), in_interface);
+      if (it != m_window_list.end())
+        in_interface->back_app_update_window();
+    }
 
-      friend class ScaleData;
+  private:
+    // member variables --------------------------------------------------------
+    std::mutex m_command_mutex;
+    std::vector<AppCommand> m_command_queue;
+    std::vector<AppCommand> m_command_work;   // (UI thread) commands being processed
+    std::atomic<bool> m_wakeup_scheduled;
+    //
+    std::vector<BackgroundAppWindowInterface *> m_window_list;
+    std::condition_variable m_window_cond;
+    std::mutex  m_window_mutex;
+
+    // friend classes ----------------------------------------------------------
+    friend class BackgroundAppRunner;
   };
 
   // ===========================================================================
-  //  ScaleData class (GtkScale)
+  //  BackgroundAppRunner class
   // ===========================================================================
-  class ScaleData : public WidgetData
+  class BackgroundAppRunner
   {
   public:
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // get_value
-      // -------------------------------------------------------------------------
-      bool get_value(double *io_value, bool in_compare = false)
+    // -------------------------------------------------------------------------
+    // BackgroundAppRunner destructor
+    // -------------------------------------------------------------------------
+    virtual ~BackgroundAppRunner()
+    {
+      if (m_app != nullptr)
+        m_app->post_quit_app();
+      if (m_thread != nullptr)
       {
-        if (io_value == nullptr)
-          return false;
-        std::lock_guard<std::mutex> lock(m_value_mutex);
-        if (in_compare)
-          if (*io_value == m_value)
-            return false;
-        *io_value = m_value;
-        return true;
+        m_thread->join();
+        delete m_thread;
+        delete m_app;
       }
-      // -------------------------------------------------------------------------
-      // set_value
-      // -------------------------------------------------------------------------
-      void set_value(double in_value, bool in_invoke_update = true)
-      {
-        if (m_scale == nullptr)
-        {
+      SHL_DBG_OUT("BackgroundAppRunner was deleted");
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // BackgroundAppRunner constructor
+    // -------------------------------------------------------------------------
+    BackgroundAppRunner() :
+      m_app(nullptr), m_thread(nullptr)
+    {
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // wait_window_all_closed
+    // -------------------------------------------------------------------------
+    void wait_window_all_closed()
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+        return;
+      m_app->wait_window_all_closed();
+    }
+    // -------------------------------------------------------------------------
+    // get_window_num
+    // -------------------------------------------------------------------------
+    size_t get_window_num()
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+        return 0;
+      return m_app->get_window_num();
+    }
+    // -------------------------------------------------------------------------
+    // is_window_close_all
+    // -------------------------------------------------------------------------
+    bool is_window_close_all()
+    {
+      if (get_window_num() == 0)
+        return true;
+      return false;
+    }
+    // -------------------------------------------------------------------------
+    // create_window
+    // -------------------------------------------------------------------------
+    void create_window(BackgroundAppWindowInterface *in_interface, const char *in_title)
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+      {
+        m_app = new BackgroundApp();
+        m_app->hold();
+      }
+      m_app->post_create_window(in_interface, in_title);
+      if (m_thread != nullptr)
+        return;
+      m_thread = new std::thread(thread_func, this);
+    }
+    // -------------------------------------------------------------------------
+    // delete_window
+    // -------------------------------------------------------------------------
+    void delete_window(BackgroundAppWindowInterface *in_interface)
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+        return;
+      m_app->post_delete_window(in_interface);
+    }
+    // -------------------------------------------------------------------------
+    // update_window
+    // -------------------------------------------------------------------------
+    void update_window(BackgroundAppWindowInterface *in_interface)
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+        return;
+      m_app->post_update_window(in_interface);
+    }
+    // -------------------------------------------------------------------------
+    // connect_timer
+    // -------------------------------------------------------------------------
+    void connect_timer(TimerData *inTimerData)
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+        return;
+      m_app->post_connect_timer(inTimerData);
+    }
+    // -------------------------------------------------------------------------
+    // disconnect_timer
+    // -------------------------------------------------------------------------
+    void disconnect_timer(TimerData *inTimerData)
+    {
+      std::lock_guard<std::mutex> lock(m_function_call_mutex);
+      if (m_app == nullptr)
+        return;
+      m_app->post_disconnect_timer(inTimerData);
+    }
+
+    // static functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // get_runner
+    // -------------------------------------------------------------------------
+    static BackgroundAppRunner *get_runner()
+    {
+      static BackgroundAppRunner s_runner;
+      return &s_runner;
+    }
+
+  private:
+    // member variables --------------------------------------------------------
+    BackgroundApp *m_app;
+    std::thread *m_thread;
+    std::mutex m_function_call_mutex;
+
+    // static functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // thread_func
+    // -------------------------------------------------------------------------
+    static void thread_func(BackgroundAppRunner *in_obj)
+    {
+      SHL_TRACE_OUT("thread started");
+      in_obj->m_app->run();
+      SHL_TRACE_OUT("thread ended");
+    }
+
+    // friend classes ----------------------------------------------------------
+    friend class WindowBase;
+  };
+
+  // ===========================================================================
+  //  Window refresh mode definitions
+  // ===========================================================================
+  enum RefreshMode
+  {
+    REFRESH_MODE_IDLE = 0,    // apply the updates from an idle callback
+    REFRESH_MODE_FRAME_CLOCK, // apply the updates once per frame (GdkFrameClock)
+    REFRESH_MODE_MAX_RATE     // apply the updates at most N times per second
+  };
+
+  // ===========================================================================
+  //  WindowBase class
+  // ===========================================================================
+  class WindowBase : private BackgroundAppWindowInterface
+  {
+  public:
+    // -------------------------------------------------------------------------
+    // WindowBase destructor
+    // -------------------------------------------------------------------------
+    virtual ~WindowBase()
+    {
+      kill_timer(nullptr);  // stop and delete all timers (just in case)
+      m_app_runner->delete_window(this);
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // wait_window_closed
+    // -------------------------------------------------------------------------
+    /**
+     * Waits until the window associated to the object is closed.
+     * @note This is a blocking function.
+     *
+     */
+    void wait_window_closed()
+    {
+      back_app_wait_delete_window();
+    }
+    // -------------------------------------------------------------------------
+    // is_window_closed
+    // -------------------------------------------------------------------------
+    /**
+     * Checks whether the opened window is closed or not.
+     * @ The window associated to this object
+     *
+     * @return Whether the window is closed or not
+     *  - true : The window was closed
+     *  - false : The window is not closed
+     */
+    bool is_window_closed()
+    {
+      return back_app_is_window_deleted();
+    }
+    // -------------------------------------------------------------------------
+    // wait_window_close_all
+    // -------------------------------------------------------------------------
+    /**
+     * Waits until all of the windows are closed.
+     * @note The windows including opened by the other objects
+     */
+    void wait_window_close_all()
+    {
+      m_app_runner->wait_window_all_closed();
+    }
+    // -------------------------------------------------------------------------
+    // is_window_close_all
+    // -------------------------------------------------------------------------
+    /**
+     * Checks whether the all windows are closed or not.
+     * @note The windows including opened by the other objects
+     *
+     * @return Whether the window is closed or not
+     *  - true : The windows were all closed
+     *  - false : The all of the windows are still not closed
+     */
+    bool is_window_close_all()
+    {
+      return m_app_runner->is_window_close_all();
+    }
+    // -------------------------------------------------------------------------
+    // get_window_num
+    // -------------------------------------------------------------------------
+    /**
+     * Retrieves the number of opened windows.
+     * @note The windows including opened by the other objects
+     *
+     * @return the number of opened windows
+     */
+    size_t get_window_num()
+    {
+      return m_app_runner->get_window_num();
+    }
+    // -------------------------------------------------------------------------
+    // show_window
+    // -------------------------------------------------------------------------
+    /**
+     * Shows a window.
+     * @note if in_title is nullptr, the title will be automatically generated.
+     *
+     * @param in_title  The title of the window
+     */
+    void show_window(const char *in_title = nullptr)
+    {
+      if (back_app_get_window() != nullptr)
+        return;
+      m_app_runner->create_window(this, in_title);
+      back_app_wait_new_window();
+      start_all_timers();
+    }
+    // -------------------------------------------------------------------------
+    // update
+    // -------------------------------------------------------------------------
+    /**
+     * Tells the library to updates the window.
+     * @note This function needs to be called when the content of the object is
+     * updated
+     */
+    void update()
+    {
+      if (back_app_get_window() == nullptr)
+        return;
+      // [Note] only one idle callback is posted while a refresh is pending.
+      // While the frame clock (or the timer) is armed, it picks the update up
+      if (m_update_pending.exchange(true))
+        return;
+      if (m_refresh_armed.load())
+        return;
+      m_app_runner->update_window(this);
+    }
+    // -------------------------------------------------------------------------
+    // set_refresh_mode
+    // -------------------------------------------------------------------------
+    /**
+     * Selects how the pending widget updates are applied on the GTK thread.
+     * REFRESH_MODE_FRAME_CLOCK and REFRESH_MODE_MAX_RATE apply all pending
+     * updates at once per frame (or per 1 / in_max_rate_hz second). The
+     * frame clock tick (or the timer) is removed again when no update is
+     * pending.
+     *
+     * @param in_mode         The refresh mode
+     * @param in_max_rate_hz  The maximum refresh rate (REFRESH_MODE_MAX_RATE)
+     */
+    void set_refresh_mode(RefreshMode in_mode, unsigned int in_max_rate_hz = 60)
+    {
+      m_max_refresh_rate.store(std::max(in_max_rate_hz, 1u));
+      m_refresh_mode.store(in_mode);
+    }
+    // -------------------------------------------------------------------------
+    // get_refresh_mode
+    // -------------------------------------------------------------------------
+    RefreshMode get_refresh_mode() const
+    {
+      return m_refresh_mode.load();
+    }
+    // -------------------------------------------------------------------------
+    // notify_widget_changed()
+    // -------------------------------------------------------------------------
+    // [Note] called from the GTK thread after a widget value was changed
+    //
+    virtual void notify_widget_changed(size_t in_widget_index)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // get_user_event_queue()
+    // -------------------------------------------------------------------------
+    EventQueue *get_user_event_queue()
+    {
+      if (m_user_event_queue != nullptr)
+        return m_user_event_queue;
+      return get_user_global_queue();
+    }
+    // -------------------------------------------------------------------------
+    // get_update_event_queue()
+    // -------------------------------------------------------------------------
+    EventQueue *get_update_event_queue()
+    {
+      return &m_background_queue;
+    }
+#ifdef SHL_GTK_COROUTINE
+    // -------------------------------------------------------------------------
+    // set_executor()
+    // -------------------------------------------------------------------------
+    /**
+     * Sets the executor that resumes the coroutines awaiting the events of
+     * this window (next_event(), changed() of the widgets).
+     * @note nullptr (default) resumes them INLINE ON THE GTK THREAD: the
+     * coroutine body then runs in the GTK main loop (a long computation
+     * freezes the windows). Set an executor (e.g. an EventQueueExecutor
+     * drained by the user thread) before the first co_await unless that
+     * is intended.
+     *
+     */
+    void set_executor(Executor *in_executor)
+    {
+      m_executor.store(in_executor);
+    }
+    // -------------------------------------------------------------------------
+    // get_executor()
+    // -------------------------------------------------------------------------
+    Executor *get_executor()
+    {
+      return m_executor.load();
+    }
+#endif
+    // -------------------------------------------------------------------------
+    // set_queue_stats_enabled()
+    // -------------------------------------------------------------------------
+    /**
+     * Enables the statistics of the user event queue and the update queue.
+     * @note The user event queue can be shared with other windows.
+     *
+     */
+    void set_queue_stats_enabled(bool in_enable)
+    {
+      get_user_event_queue()->set_stats_enabled(in_enable);
+      m_background_queue.set_stats_enabled(in_enable);
+    }
+    // -------------------------------------------------------------------------
+    // get_user_queue_stats()
+    // -------------------------------------------------------------------------
+    EventQueue::Stats get_user_queue_stats()
+    {
+      return get_user_event_queue()->get_stats();
+    }
+    // -------------------------------------------------------------------------
+    // get_update_queue_stats()
+    // -------------------------------------------------------------------------
+    EventQueue::Stats get_update_queue_stats()
+    {
+      return m_background_queue.get_stats();
+    }
+    // -------------------------------------------------------------------------
+    // push_update_event()
+    // -------------------------------------------------------------------------
+    void push_update_event(void *inSource, void (*in_func)(EventData *))
+    {
+      m_background_queue.push(inSource, in_func);
+    }
+    // -------------------------------------------------------------------------
+    // push_update_event()
+    // -------------------------------------------------------------------------
+    void push_update_event(EventData *in_update)
+    {
+      m_background_queue.push(in_update);
+    }
+    // -------------------------------------------------------------------------
+    // add_close_event_listener
+    // -------------------------------------------------------------------------
+    void add_close_event_listener(base::EventQueue *in_event_queue)
+    {
+      m_close_notify_list.push_back(in_event_queue);
+    }
+    // -------------------------------------------------------------------------
+    // connect_timer
+    // -------------------------------------------------------------------------
+    TimerData *add_timer(
+                  unsigned int in_interval_ms,
+                  void (*in_timer_event_func)(void *in_user_data) = nullptr,
+                  void *in_user_data = nullptr,
+                  base::EventQueue *in_user_event_queue = nullptr)
+    {
+      if (in_user_event_queue == nullptr)
+        in_user_event_queue = get_user_event_queue();
+      TimerData *timer;
+      timer = new TimerData(
+              in_interval_ms,
+              in_user_event_queue,
+              in_timer_event_func,
+              in_user_data);
+      m_timer_list.push_back(timer);
+      return timer;
+    }
+    // -------------------------------------------------------------------------
+    // kill_timer
+    // -------------------------------------------------------------------------
+    // [note]
+    // after calling this function, passed inTimeData will be no
+    // longer valid (the linked object will be deleted internally)
+    // specifying nullptr will remove all timers associated with this window
+    //
+    void kill_timer(TimerData *inTimerData = nullptr)
+    {
+      if (inTimerData == nullptr)
+        return;
+      
+      for (auto it = m_timer_list.begin(); it != m_timer_list.end(); it++)
+        if ((*it) == inTimerData || inTimerData == nullptr)
+        {
+          m_app_runner->disconnect_timer((*it));
+          delete (*it);
+          if (inTimerData != nullptr)
+          {
+            m_timer_list.erase(it);
+            break;
+          }
+        }
+      if (inTimerData == nullptr)
+        m_timer_list.clear();
+    }
+
+  protected:
+    // Virtual Member functions --------------------------------------------------------
+    virtual Gtk::Window *create_window_object(const char *in_title) = 0;
+    virtual Gtk::Window *get_window_object() = 0;
+    virtual void delete_window_object() = 0;
+    virtual bool is_window_object_null() = 0;
+    virtual void update_window() = 0;
+    virtual const char *get_default_window_title() = 0;
+
+    // -------------------------------------------------------------------------
+    // WindowBase constructor
+    // -------------------------------------------------------------------------
+    WindowBase(EventQueue *in_user_event_queue = nullptr) :
+      m_user_event_queue(in_user_event_queue)
+#ifdef SHL_GTK_COROUTINE
+      , m_executor(nullptr)
+#endif
+      , m_refresh_mode(REFRESH_MODE_IDLE),
+      m_max_refresh_rate(60),
+      m_update_pending(false), m_refresh_armed(false)
+    {
+      m_app_runner = BackgroundAppRunner::get_runner();
+    }
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // process_update_events()
+    // -------------------------------------------------------------------------
+    void process_update_events(bool in_last_only = false)
+    {
+      m_background_queue.process_events(in_last_only);
+    }
+    // -------------------------------------------------------------------------
+    // start_all_timers
+    // -------------------------------------------------------------------------
+    void start_all_timers()
+    {
+      for (auto it = m_timer_list.begin(); it != m_timer_list.end(); it++)
+        m_app_runner->connect_timer((*it));
+    }
+
+  private:
+    // member variables --------------------------------------------------------
+    BackgroundAppRunner *m_app_runner;
+    EventQueue  m_background_queue;
+    EventQueue  *m_user_event_queue;
+    std::condition_variable m_new_window_cond;
+    std::mutex  m_new_window_mutex;
+    std::condition_variable m_delete_window_cond;
+    std::mutex  m_delete_window_mutex;
+    std::vector<base::EventQueue *> m_close_notify_list;
+#ifdef SHL_GTK_COROUTINE
+    std::atomic<Executor *> m_executor;
+#endif
+    std::vector<TimerData *>   m_timer_list;
+    std::atomic<RefreshMode>  m_refresh_mode;
+    std::atomic<unsigned int> m_max_refresh_rate;
+    std::atomic<bool> m_update_pending;
+    std::atomic<bool> m_refresh_armed;  // the tick callback or the timer is running
+    sigc::connection  m_refresh_timer;
+
+    // BackgroundAppWindowInterface functions ----------------------------------
+    // -------------------------------------------------------------------------
+    // back_app_create_window (called from the UI thread)
+    // -------------------------------------------------------------------------
+    Gtk::Window *back_app_create_window(const char *in_title) override
+    {
+      static int window_num = 0;
+      char buf[256];
+      if (in_title != nullptr)
+        if (*in_title == 0)
+          in_title = nullptr;
+      if (in_title == nullptr)
+      {
+        const char *title = get_default_window_title();
+        if (window_num == 0)
+          sprintf(buf, "%s", title);
+        else
+          sprintf(buf, "%s_%d", title, window_num);
+        in_title = buf;
+      }
+      Gtk::Window *window = create_window_object(in_title);
+      m_new_window_cond.notify_all();
+      window_num++;
+      return window;
+    }
+    // -------------------------------------------------------------------------
+    // back_app_wait_new_window (called from the UI thread)
+    // -------------------------------------------------------------------------
+    void back_app_wait_new_window() override
+    {
+      std::unique_lock<std::mutex> lock(m_new_window_mutex);
+      m_new_window_cond.wait(lock);
+    }
+    // -------------------------------------------------------------------------
+    // back_app_delete_request (called from the UI thread)
+    // -------------------------------------------------------------------------
+    Gtk::Window *back_app_get_window() override
+    {
+      return get_window_object();
+    }
+    // -------------------------------------------------------------------------
+    // back_app_delete_request (called from the UI thread)
+    // -------------------------------------------------------------------------
+    bool back_app_delete_request() override
+    {
+      return false; // by returning true, we can cancel window close
+    }
+    // -------------------------------------------------------------------------
+    // back_app_delete_window (called from the UI thread)
+    // -------------------------------------------------------------------------
+    void back_app_delete_window() override
+    {
+      // we need to disconnect all timers first
+      for (auto it = m_timer_list.begin(); it != m_timer_list.end(); it++)
+        (*it)->disconnect();
+      m_refresh_timer.disconnect();
+      m_refresh_armed.store(false);
+      m_update_pending.store(false);
+      delete_window_object();
+      m_delete_window_cond.notify_all();
+      // We need to notify all event queues to un-block event queue's wait()
+      for (auto it = m_close_notify_list.begin(); it != m_close_notify_list.end(); it++)
+        (*it)->notify();
+    }
+    // -------------------------------------------------------------------------
+    // back_app_is_window_deleted (called from the UI thread)
+    // -------------------------------------------------------------------------
+    bool back_app_is_window_deleted() override
+    {
+      return is_window_object_null();
+    }
+    // -------------------------------------------------------------------------
+    // back_app_wait_delete_window (called from the UI thread)
+    // -------------------------------------------------------------------------
+    void back_app_wait_delete_window() override
+    {
+      std::unique_lock<std::mutex> lock(m_delete_window_mutex);
+      m_delete_window_cond.wait(lock);
+    }
+    // -------------------------------------------------------------------------
+    // back_app_update_window
+    // -------------------------------------------------------------------------
+    void back_app_update_window() override
+    {
+      RefreshMode mode = m_refresh_mode.load();
+      Gtk::Window *window = back_app_get_window();
+      if (mode == REFRESH_MODE_IDLE || window == nullptr)
+      {
+        m_update_pending.store(false);
+        update_window();
+        return;
+      }
+      if (m_refresh_armed.load())
+        return;   // the next tick applies the update
+      m_refresh_armed.store(true);
+      if (mode == REFRESH_MODE_FRAME_CLOCK)
+        window->add_tick_callback(sigc::mem_fun(*this, &WindowBase::on_refresh_tick));
+      else
+        m_refresh_timer = Glib::signal_timeout().connect(
+                sigc::mem_fun(*this, &WindowBase::on_refresh),
+                std::max(1000u / m_max_refresh_rate.load(), 1u));
+    }
+    // -------------------------------------------------------------------------
+    // on_refresh_tick (called from the UI thread)
+    // -------------------------------------------------------------------------
+    bool on_refresh_tick(const Glib::RefPtr<Gdk::FrameClock> &in_frame_clock)
+    {
+      return on_refresh();
+    }
+    // -------------------------------------------------------------------------
+    // on_refresh (called from the UI thread)
+    // -------------------------------------------------------------------------
+    // [Note] returning false removes the tick callback (or the timer)
+    //
+    bool on_refresh()
+    {
+      if (m_update_pending.exchange(false))
+      {
+        update_window();
+        return true;
+      }
+      // Nothing to do: disarm, but re-check the pending flag because update()
+      // may have seen m_refresh_armed == true just before we cleared it
+      m_refresh_armed.store(false);
+      if (m_update_pending.load())
+      {
+        m_refresh_armed.store(true);
+        return true;
+      }
+      return false;
+    }
+    // static functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // get_user_global_queue
+    // -------------------------------------------------------------------------
+    static EventQueue *get_user_global_queue()
+    {
+      static EventQueue s_user_global_queue;
+      return &s_user_global_queue;
+    }
+  };
+} // namespace shl::gtk::base
+#else
+  // If another shl file is already included, we need to is_valid the base gtk class version
+  #if SHL_BASE_GTK_CLASS_VERSION != SHL_CONTROLS_WINDOW_GTK_BASE_VERSION
+    #error invalid shl base class version (There is a version inconsistency between included shl files)
+  #endif
+  //
+#endif  // SHL_BASE_GTK_CLASS_
+
+// The followings are for the friend class definition
+class ControlsWindow;
+
+// Namespace -------------------------------------------------------------------
+namespace controls     // shl::gtk::controls
+{
+  // ===========================================================================
+  //  SnapshotValue struct
+  // ===========================================================================
+  struct SnapshotValue
+  {
+    double  m_double = 0.0; // spin button, scale
+    int     m_int = 0;      // combo box (active row number)
+    bool    m_bool = false; // switch
+    std::string m_text;     // label, entry
+  };
+
+  // ===========================================================================
+  //  Snapshot class
+  // ===========================================================================
+  // Immutable copy of all widget values of a window (see
+  // WindowData::acquire_snapshot()). Values are indexed in the order the
+  // widgets were added.
+  //
+  class Snapshot
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // size
+    // -------------------------------------------------------------------------
+    size_t size() const
+    {
+      return m_values.size();
+    }
+    // -------------------------------------------------------------------------
+    // at
+    // -------------------------------------------------------------------------
+    const SnapshotValue &at(size_t in_index) const
+    {
+      return m_values.at(in_index);
+    }
+    // -------------------------------------------------------------------------
+    // get
+    // -------------------------------------------------------------------------
+    // [Note] returns nullptr when in_widget was added after this snapshot
+    //
+    template <class W>
+    const SnapshotValue *get(const W *in_widget) const
+    {
+      size_t index = in_widget->get_index();
+      if (index >= m_values.size())
+        return nullptr;
+      return &m_values[index];
+    }
+    // -------------------------------------------------------------------------
+    // get_generation
+    // -------------------------------------------------------------------------
+    // [Note] 0 until the first snapshot was published
+    //
+    uint64_t get_generation() const
+    {
+      return m_generation;
+    }
+
+  private:
+    // member variables --------------------------------------------------------
+    std::vector<SnapshotValue> m_values;
+    uint64_t m_generation = 0;
+
+    // friend classes ----------------------------------------------------------
+    friend class WindowData;
+  };
+
+  // ===========================================================================
+  //  ParamsBindingBase class
+  // ===========================================================================
+  class WidgetData;
+  template <class P> class ParamsBinding;
+  //
+  class ParamsBindingBase
+  {
+  public:
+    // -------------------------------------------------------------------------
+    // ParamsBindingBase destructor
+    // -------------------------------------------------------------------------
+    virtual ~ParamsBindingBase() = default;
+
+  protected:
+    // Virtual Member functions ------------------------------------------------
+    // [Note] called from the GTK thread when a bound widget was changed
+    virtual void store_field(const WidgetData *in_widget,
+                             void (*in_store)(const WidgetData *, void *)) = 0;
+    // [Note] called from the GTK thread by WindowData::publish_changes()
+    virtual void publish() = 0;
+
+    // friend classes ----------------------------------------------------------
+    friend class WidgetData;
+    friend class WindowData;
+  };
+
+  // ===========================================================================
+  //  WidgetData class
+  // ===========================================================================
+  class WidgetData
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // is_updated
+    // -------------------------------------------------------------------------
+    bool is_updated() const
+    {
+      return m_is_updated.load(std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    // get_index
+    // -------------------------------------------------------------------------
+    // [Note] index of the widget in the window (and in Snapshot)
+    //
+    size_t get_index() const
+    {
+      return m_index;
+    }
+    // -------------------------------------------------------------------------
+    // get_user_event_queue()
+    // -------------------------------------------------------------------------
+    base::EventQueue *get_user_event_queue()
+    {
+      if (m_user_event_queue != nullptr)
+        return m_user_event_queue;
+      return m_window->get_user_event_queue();
+    }
+    // -------------------------------------------------------------------------
+    // set_event_priority()
+    // -------------------------------------------------------------------------
+    // [Note] only used when the user event queue is not in LANE_MODE_FIFO
+    //
+    void set_event_priority(base::EventPriority in_priority)
+    {
+      m_event_priority = in_priority;
+    }
+    // -------------------------------------------------------------------------
+    // get_event_priority()
+    // -------------------------------------------------------------------------
+    base::EventPriority get_event_priority() const
+    {
+      return m_event_priority;
+    }
+    // -------------------------------------------------------------------------
+    // set_latest_value_only()
+    // -------------------------------------------------------------------------
+    // When enabled, set_value() overwrites a single pending value and the GTK
+    // thread applies only the newest one per refresh (intermediate values are
+    // skipped). Supported by LabelData, EntryData and ScaleData.
+    // [Note] the handoff is lock-free with one producer: call set_value() of
+    // a LabelData or EntryData from one thread only in this mode
+    //
+    void set_latest_value_only(bool in_enable)
+    {
+      m_latest_value_only.store(in_enable, std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    // is_latest_value_only()
+    // -------------------------------------------------------------------------
+    bool is_latest_value_only() const
+    {
+      return m_latest_value_only.load(std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    // is_initialized
+    // -------------------------------------------------------------------------
+    // [Note] true after the window view was created. Before that the setters
+    // write the initial values directly
+    //
+    bool is_initialized() const
+    {
+      return m_is_initialized.load(std::memory_order_acquire);
+    }
+    // -------------------------------------------------------------------------
+    // set_number
+    // -------------------------------------------------------------------------
+    // Type independent set_value() for the widgets found by name (see
+    // WindowData::find()). Returns false if the widget has no numeric value.
+    // switch: != 0, combo box: the row number
+    //
+    virtual bool set_number(double in_value, bool in_invoke_update = true)
+    {
+      return false;
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // WidgetData constructor
+    // -------------------------------------------------------------------------
+    WidgetData(base::WindowBase *in_window,
+            const char *in_label_str,
+            base::EventQueue *in_user_event_queue = nullptr) :
+        m_window(in_window),
+        m_label_str(in_label_str),
+        m_user_event_queue(in_user_event_queue),
+        m_horiz_box(nullptr), m_label(nullptr),
+        m_is_initialized(false),
+        m_is_updated(false),
+        m_event_priority(base::EVENT_PRIORITY_NORMAL),
+        m_index(0),
+        m_parent(nullptr),
+        m_is_filtered_out(false),
+        m_params_binding(nullptr), m_params_store(nullptr),
+        m_latest_value_only(false)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // WidgetData destructor
+    // -------------------------------------------------------------------------
+    virtual ~WidgetData()
+    {
+      delete m_horiz_box;
+      delete m_label;
+    }
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    virtual Gtk::Box *create()
+    {
+      m_horiz_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_HORIZONTAL);
+      m_label = new Gtk::Label(m_label_str.c_str());
+
+      m_horiz_box->set_margin_left(8);
+      m_horiz_box->set_margin_right(8);
+      m_horiz_box->set_margin_top(2);
+      m_horiz_box->set_margin_bottom(2);
+      m_horiz_box->pack_start(*m_label, Gtk::PACK_SHRINK);
+      return m_horiz_box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    // [Note] called from the GTK thread when a virtualized view scrolls the
+    // row out. Deletes the GTK widgets; the values are kept in the WidgetData
+    // and the next create() restores them
+    //
+    virtual void release()
+    {
+      delete m_label;
+      delete m_horiz_box;
+      m_label = nullptr;
+      m_horiz_box = nullptr;
+    }
+    // -------------------------------------------------------------------------
+    // is_created
+    // -------------------------------------------------------------------------
+    // [Note] GTK thread only
+    //
+    bool is_created() const
+    {
+      return m_horiz_box != nullptr;
+    }
+    // -------------------------------------------------------------------------
+    // initialize
+    // -------------------------------------------------------------------------
+    // [Note] called once from the WindowView constructor (before any create())
+    //
+    void initialize()
+    {
+      init_values();
+      m_is_initialized.store(true, std::memory_order_release);
+    }
+    // -------------------------------------------------------------------------
+    // init_values
+    // -------------------------------------------------------------------------
+    // [Note] copies the initial values to the mirrors and the user variables
+    //
+    virtual void init_values()
+    {
+    }
+    // -------------------------------------------------------------------------
+    // is_container
+    // -------------------------------------------------------------------------
+    // [Note] true for GroupData, PageData and NotebookData
+    //
+    virtual bool is_container() const
+    {
+      return false;
+    }
+    // -------------------------------------------------------------------------
+    // get_row_height
+    // -------------------------------------------------------------------------
+    // [Note] the height of the row in the virtualized view. in_row_height is
+    // the one of WindowData::set_virtualized_view(), taller widgets return
+    // their own height
+    //
+    virtual int get_row_height(int in_row_height) const
+    {
+      return in_row_height;
+    }
+    // -------------------------------------------------------------------------
+    // apply_filter
+    // -------------------------------------------------------------------------
+    // [Note] called after show_all() of a created row: hides it if it is
+    // filtered out by WindowView::set_filter()
+    //
+    void apply_filter()
+    {
+      if (m_is_filtered_out)
+        m_horiz_box->hide();
+    }
+    // -------------------------------------------------------------------------
+    // mark_as_updated()
+    // -------------------------------------------------------------------------
+    void mark_as_updated()
+    {
+      m_is_updated.store(true, std::memory_order_relaxed);
+      if (m_params_binding != nullptr)
+        m_params_binding->store_field(this, m_params_store);
+      m_window->notify_widget_changed(m_index);
+    }
+    // -------------------------------------------------------------------------
+    // store_snapshot()
+    // -------------------------------------------------------------------------
+    // [Note] called from the GTK thread
+    //
+    virtual void store_snapshot(SnapshotValue *out_value) const
+    {
+    }
+    // -------------------------------------------------------------------------
+    // get_event_pool()
+    // -------------------------------------------------------------------------
+    base::EventPool *get_event_pool()
+    {
+      return get_user_event_queue()->get_event_pool();
+    }
+#ifdef SHL_GTK_COROUTINE
+    // -------------------------------------------------------------------------
+    // get_executor()
+    // -------------------------------------------------------------------------
+    base::Executor *get_executor()
+    {
+      return m_window->get_executor();
+    }
+#endif
+    // -------------------------------------------------------------------------
+    // get_update_pool()
+    // -------------------------------------------------------------------------
+    base::EventPool *get_update_pool()
+    {
+      return m_window->get_update_event_queue()->get_event_pool();
+    }
+    // -------------------------------------------------------------------------
+    // push_event()
+    // -------------------------------------------------------------------------
+    void push_event(void (*in_func)(base::EventData *))
+    {
+      get_user_event_queue()->push(this, in_func, m_event_priority);
+    }
+    // -------------------------------------------------------------------------
+    // push_event()
+    // -------------------------------------------------------------------------
+    void push_event(base::EventData *in_event)
+    {
+      get_user_event_queue()->push(in_event, m_event_priority);
+    }
+    // -------------------------------------------------------------------------
+    // push_value()
+    // -------------------------------------------------------------------------
+    // [Note] in_value is stored inline in the queue (nothing is allocated)
+    //
+    void push_value(base::EventRecordHandler in_func, const base::EventValue &in_value)
+    {
+      get_user_event_queue()->push(this, in_func, in_value, m_event_priority);
+    }
+    // -------------------------------------------------------------------------
+    // push_update()
+    // -------------------------------------------------------------------------
+    void push_update(void (*in_func)(base::EventData *))
+    {
+      m_window->push_update_event(this, in_func);
+    }
+    // -------------------------------------------------------------------------
+    // push_update()
+    // -------------------------------------------------------------------------
+    void push_update(base::EventData *in_update)
+    {
+      m_window->push_update_event(in_update);
+    }
+    // -------------------------------------------------------------------------
+    // invoke_update()
+    // -------------------------------------------------------------------------
+    void invoke_update()
+    {
+      m_window->update();
+    }
+
+  private:
+    // member variables --------------------------------------------------------
+    base::WindowBase *m_window;
+    base::EventQueue *m_user_event_queue;
+
+    Gtk::Box    *m_horiz_box;
+    Gtk::Label  *m_label;
+    std::string  m_label_str;
+    std::atomic<bool> m_is_initialized;
+    std::atomic<bool> m_is_updated;
+    base::EventPriority m_event_priority;
+    size_t m_index;
+    WidgetData *m_parent;   // GroupData / NotebookData (nullptr: top level)
+    bool m_is_filtered_out; // (GTK thread) hidden by WindowView::set_filter()
+    ParamsBindingBase *m_params_binding;
+    void (*m_params_store)(const WidgetData *, void *);
+    std::atomic<bool> m_latest_value_only;
+
+    friend class WindowData;
+    friend class WindowView;
+    friend class GroupData;
+    friend class PageData;
+    friend class NotebookData;
+    template <class P> friend class ParamsBinding;
+  };
+
+  // ===========================================================================
+  //  ButtonData class (GtkButton)
+  // ===========================================================================
+  class ButtonData : public WidgetData
+  {
+  protected:
+    // -------------------------------------------------------------------------
+    // ButtonData destructor
+    // -------------------------------------------------------------------------
+    ~ButtonData() override
+    {
+      delete m_button;
+    }
+
+    // -------------------------------------------------------------------------
+    // ButtonData constructor
+    // -------------------------------------------------------------------------
+    ButtonData(base::WindowBase *in_window,
+               const char *in_label_str,
+               const char *in_button_str,
+               void *in_user_data = nullptr,
+               void (*in_clicked_func)(void *in_user_data) = nullptr,
+               void (*in_pressed_func)(void *in_user_data) = nullptr,
+               void (*in_released_func)(void *in_user_data) = nullptr,
+               base::EventQueue *in_user_event_queue = nullptr) :
+            WidgetData(in_window, in_label_str, in_user_event_queue),
+            m_button_str(in_button_str),
+            m_user_data(in_user_data),
+            m_clicked_func(in_clicked_func),
+            m_pressed_func(in_pressed_func),
+            m_released_func(in_released_func),
+            m_button(nullptr)
+    {
+      set_event_priority(base::EVENT_PRIORITY_HIGH);
+    }
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      Gtk::Box  *box = WidgetData::create();
+      if (box == nullptr)
+        return nullptr;
+      m_button = new Gtk::Button(m_button_str.c_str());
+      if (m_button == nullptr)
+        return nullptr;
+      m_button->signal_clicked().connect(
+              sigc::mem_fun(*this, &ButtonData::queue_button_clicked));
+      m_button->signal_pressed().connect(
+              sigc::mem_fun(*this, &ButtonData::queue_button_pressed));
+      m_button->signal_released().connect(
+              sigc::mem_fun(*this, &ButtonData::queue_button_released));
+      box->pack_end(*m_button, Gtk::PACK_SHRINK);
+      return box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    void release() override
+    {
+      delete m_button;
+      m_button = nullptr;
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // queue_button_clicked
+    // -------------------------------------------------------------------------
+    void queue_button_clicked()
+    {
+      if (m_clicked_func == nullptr)
+        return;
+      push_event(process_button_clicked);
+    }
+    // -------------------------------------------------------------------------
+    // queue_button_pressed
+    // -------------------------------------------------------------------------
+    void queue_button_pressed()
+    {
+      if (m_pressed_func == nullptr)
+        return;
+      push_event(process_button_pressed);
+    }
+    // -------------------------------------------------------------------------
+    // queue_button_released
+    // -------------------------------------------------------------------------
+    void queue_button_released()
+    {
+      if (m_released_func == nullptr)
+        return;
+      push_event(process_button_released);
+    }
+    // -------------------------------------------------------------------------
+    // process_button_clicked
+    // -------------------------------------------------------------------------
+    static void process_button_clicked(base::EventData *in_event)
+    {
+      auto  *button = (ButtonData *)in_event->get_source();
+      button->m_clicked_func(button->m_user_data);
+    }
+    // -------------------------------------------------------------------------
+    // process_button_pressed
+    // -------------------------------------------------------------------------
+    static void process_button_pressed(base::EventData *in_event)
+    {
+      auto  *button = (ButtonData *)in_event->get_source();
+      button->m_pressed_func(button->m_user_data);
+    }
+    // -------------------------------------------------------------------------
+    // process_button_released
+    // -------------------------------------------------------------------------
+    static void process_button_released(base::EventData *in_event)
+    {
+      auto  *button = (ButtonData *)in_event->get_source();
+      button->m_released_func(button->m_user_data);
+    }
+
+  private:
+    // member variables --------------------------------------------------------
+    Gtk::Button *m_button;
+    std::string m_button_str;
+    void *m_user_data;
+    void (*m_clicked_func)(void *in_user_data);
+    void (*m_pressed_func)(void *in_user_data);
+    void (*m_released_func)(void *in_user_data);
+
+    friend class WindowData;
+    friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  LabelUpdate class
+  // ===========================================================================
+  class LabelUpdate : public base::EventData
+  {
+  protected:
+      // member variables --------------------------------------------------------
+      bool m_value_updated;
+      std::string m_text;
+
+      // -------------------------------------------------------------------------
+      // LabelUpdate constructor
+      // -------------------------------------------------------------------------
+      LabelUpdate(const char *in_text,
+                  WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+          m_text(in_text),
+          m_value_updated(true),
+          base::EventData(in_source_widget, in_handler)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // LabelUpdate destructor
+      // -------------------------------------------------------------------------
+      ~LabelUpdate() override = default;
+
+      friend class LabelData;
+  };
+
+  // ===========================================================================
+  //  LabelData class (GtkLabel)
+  // ===========================================================================
+  class LabelData : public WidgetData
+  {
+  public:
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // get_value
+      // -------------------------------------------------------------------------
+      bool get_value(std::string *io_text, bool in_compare = false)
+      {
+        if (io_text == nullptr)
+          return false;
+        return m_text.load(io_text, in_compare);
+      }
+      // -------------------------------------------------------------------------
+      // set_value
+      // -------------------------------------------------------------------------
+      void set_value(const char *in_text, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_text = in_text;
+          return;
+        }
+        if (is_latest_value_only())
+        {
+          if (m_pending_text.store(in_text) == false)
+            return;   // the queued update applies the new text
+          push_update(process_pending_text);
+        }
+        else
+        {
+          auto *update = new (get_update_pool()) LabelUpdate(in_text, this, process_update);
+          push_update(update);
+        }
+        if (in_invoke_update)
+          invoke_update();
+      }
+
+  protected:
+      // -------------------------------------------------------------------------
+      // LabelData constructor
+      // -------------------------------------------------------------------------
+      LabelData(base::WindowBase *in_window,
+                const char *in_label_str,
+                const char *in_text,
+                base::EventQueue *in_user_event_queue = nullptr) :
+          WidgetData(in_window, in_label_str, in_user_event_queue),
+          m_initial(in_text, nullptr, nullptr),
+          m_static_text(nullptr)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // LabelData destructor
+      // -------------------------------------------------------------------------
+      ~LabelData() override
+      {
+        delete m_static_text;
+      }
+
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // create
+      // -------------------------------------------------------------------------
+      Gtk::Box *create() override
+      {
+        Gtk::Box  *box = WidgetData::create();
+        if (box == nullptr)
+          return nullptr;
+        m_static_text = new Gtk::Label(m_initial.m_text);
+        if (m_static_text == nullptr)
+          return nullptr;
+        box->pack_end(*m_static_text, Gtk::PACK_SHRINK);
+        return box;
+      }
+      // -------------------------------------------------------------------------
+      // release
+      // -------------------------------------------------------------------------
+      void release() override
+      {
+        delete m_static_text;
+        m_static_text = nullptr;
+        WidgetData::release();
+      }
+      // -------------------------------------------------------------------------
+      // init_values
+      // -------------------------------------------------------------------------
+      void init_values() override
+      {
+        m_text.store(m_initial.m_text);
+      }
+      // -------------------------------------------------------------------------
+      // store_snapshot
+      // -------------------------------------------------------------------------
+      void store_snapshot(SnapshotValue *out_value) const override
+      {
+        m_text.load(&out_value->m_text, true);
+      }
+      // -------------------------------------------------------------------------
+      // process_update
+      // -------------------------------------------------------------------------
+      static void process_update(base::EventData *in_update)
+      {
+        auto *update = (LabelUpdate *) in_update;
+        auto *label = (LabelData *) update->get_source();
+
+        if (update->m_value_updated)
+        {
+          label->apply_text(update->m_text);
+          return;
+        }
+      }
+      // -------------------------------------------------------------------------
+      // process_pending_text
+      // -------------------------------------------------------------------------
+      static void process_pending_text(base::EventData *in_update)
+      {
+        auto *label = (LabelData *) in_update->get_source();
+        label->m_pending_text.take(&label->m_applied_text);
+        label->apply_text(label->m_applied_text);
+      }
+      // -------------------------------------------------------------------------
+      // apply_text
+      // -------------------------------------------------------------------------
+      void apply_text(const std::string &in_text)
+      {
+        m_initial.m_text = in_text;   // (restored by create())
+        if (m_static_text != nullptr)
+          m_static_text->set_label(in_text);
+        m_text.store(in_text);
+        mark_as_updated();
+      }
+
+  private:
+      Gtk::Label *m_static_text;
+      LabelUpdate  m_initial;
+      base::LatestValueSlot<std::string> m_pending_text;
+      std::string m_applied_text;   // (GTK thread) buffer for m_pending_text
+
+      base::SeqLockString m_text;
+
+      friend class WindowData;
+      friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  EntryEvent class
+  // ===========================================================================
+  class EntryEvent : public base::EventData
+  {
+  protected:
+    // member variables --------------------------------------------------------
+    std::string m_text;
+
+    // -------------------------------------------------------------------------
+    // EntryEvent constructor
+    // -------------------------------------------------------------------------
+    EntryEvent(const std::string &in_text,
+            WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+            base::EventData(in_source_widget, in_handler),
+            m_text(in_text)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // EntryEvent destructor
+    // -------------------------------------------------------------------------
+    ~EntryEvent() override = default;
+
+    friend class EntryData;
+  };
+
+  // ===========================================================================
+  //  EntryUpdate class
+  // ===========================================================================
+  class EntryUpdate : public base::EventData
+  {
+  protected:
+      // member variables --------------------------------------------------------
+      bool m_value_updated;
+      std::string m_text;
+
+      // -------------------------------------------------------------------------
+      // EntryUpdate constructor
+      // -------------------------------------------------------------------------
+      EntryUpdate(const std::string &in_text,
+                  WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+          m_text(in_text),
+          m_value_updated(true),
+          base::EventData(in_source_widget, in_handler)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // EntryUpdate destructor
+      // -------------------------------------------------------------------------
+      ~EntryUpdate() override = default;
+
+      friend class EntryData;
+  };
+
+  // ===========================================================================
+  //  EntryData class (GtkEntry)
+  // ===========================================================================
+  class EntryData : public WidgetData
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // get_value
+    // -------------------------------------------------------------------------
+    bool get_value(std::string *io_text, bool in_compare = false)
+    {
+      if (io_text == nullptr)
+        return false;
+      return m_text.load(io_text, in_compare);
+    }
+    // -------------------------------------------------------------------------
+    // set_value
+    // -------------------------------------------------------------------------
+    void set_value(const std::string &in_text, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_text = in_text;
+        return;
+      }
+      if (is_latest_value_only())
+      {
+        if (m_pending_text.store(in_text) == false)
+          return;   // the queued update applies the new text
+        push_update(process_pending_text);
+      }
+      else
+      {
+        auto *update = new (get_update_pool()) EntryUpdate(in_text, this, process_update);
+        push_update(update);
+      }
+      if (in_invoke_update)
+        invoke_update();
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // EntryData constructor
+    // -------------------------------------------------------------------------
+    EntryData(base::WindowBase *in_window,
+              const char *in_label_str,
+              std::string *in_user_text,
+              int in_max_length = -1,
+              void *in_user_data = nullptr,
+              void (*in_changed_func)(void *, std::string) = nullptr,
+              void (*in_done_func)(void *, std::string) = nullptr,
+              base::EventQueue *in_user_event_queue = nullptr) :
+            WidgetData(in_window, in_label_str, in_user_event_queue),
+            m_user_text(in_user_text),
+            m_max_length(in_max_length),
+            m_initial("", nullptr, nullptr),
+            m_user_data(in_user_data),
+            m_changed_func(in_changed_func),
+            m_done_func(in_done_func),
+            m_entry(nullptr)
+    {
+      if (in_user_text != nullptr)
+        m_initial.m_text = *in_user_text;
+      set_event_priority(base::EVENT_PRIORITY_LOW);  // bulk text changes
+    }
+    // -------------------------------------------------------------------------
+    // EntryData destructor
+    // -------------------------------------------------------------------------
+    ~EntryData() override
+    {
+      delete m_entry;
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      Gtk::Box  *box = WidgetData::create();
+      if (box == nullptr)
+        return nullptr;
+      m_entry = new Gtk::Entry();
+      if (m_entry == nullptr)
+        return nullptr;
+      if (m_max_length >= 0)
+        m_entry->set_max_length(m_max_length);
+      m_entry->set_text(m_initial.m_text);
+      m_entry->signal_changed().connect(
+              sigc::mem_fun(*this, &EntryData::queue_changed));
+      m_entry->signal_editing_done().connect(
+              sigc::mem_fun(*this, &EntryData::queue_done));
+      box->pack_end(*m_entry, Gtk::PACK_SHRINK);
+      return box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    void release() override
+    {
+      m_text.load(&m_initial.m_text);
+      delete m_entry;
+      m_entry = nullptr;
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // init_values
+    // -------------------------------------------------------------------------
+    void init_values() override
+    {
+      m_text.store(m_initial.m_text);
+    }
+    // -------------------------------------------------------------------------
+    // store_snapshot
+    // -------------------------------------------------------------------------
+    void store_snapshot(SnapshotValue *out_value) const override
+    {
+      m_text.load(&out_value->m_text, true);
+    }
+    // -------------------------------------------------------------------------
+    // queue_event
+    // -------------------------------------------------------------------------
+    void queue_event(void (*in_func)(base::EventData *), bool in_has_handler)
+    {
+      queue_text(m_entry->get_buffer()->get_text().c_str(), in_func, in_has_handler);
+    }
+    // -------------------------------------------------------------------------
+    // queue_text
+    // -------------------------------------------------------------------------
+    void queue_text(const std::string &text,
+                    void (*in_func)(base::EventData *), bool in_has_handler)
+    {
+      m_text.store(text);
+      mark_as_updated();
+      if (in_has_handler == false && m_user_text == nullptr)
+        return;
+      auto *event = new (get_event_pool()) EntryEvent(
+              text,
+              this, in_func);
+      push_event(event);
+    }
+    // -------------------------------------------------------------------------
+    // queue_changed
+    // -------------------------------------------------------------------------
+    void queue_changed()
+    {
+      queue_event(process_changed,
+                  m_changed_func != nullptr || m_changed_callback.is_set());
+    }
+    // -------------------------------------------------------------------------
+    // queue_done
+    // -------------------------------------------------------------------------
+    void queue_done()
+    {
+      queue_event(process_done,
+                  m_done_func != nullptr || m_done_callback.is_set());
+    }
+    // -------------------------------------------------------------------------
+    // process_changed
+    // -------------------------------------------------------------------------
+    static void process_changed(base::EventData *in_event)
+    {
+      auto *event = (EntryEvent *)in_event;
+      auto  *entry = (EntryData *)event->get_source();
+
+      if (entry->m_user_text != nullptr)
+        *(entry->m_user_text) = event->m_text;
+      if (entry->m_changed_func != nullptr)
+        entry->m_changed_func(entry->m_user_data, event->m_text);
+      if (entry->m_changed_callback)
+        entry->m_changed_callback(std::string_view(event->m_text));
+    }
+    // -------------------------------------------------------------------------
+    // process_done
+    // -------------------------------------------------------------------------
+    static void process_done(base::EventData *in_event)
+    {
+      auto *event = (EntryEvent *)in_event;
+      auto  *entry = (EntryData *)event->get_source();
+
+      if (entry->m_user_text != nullptr)
+        *(entry->m_user_text) = event->m_text;
+      if (entry->m_done_func != nullptr)
+        entry->m_done_func(entry->m_user_data, event->m_text);
+      if (entry->m_done_callback)
+        entry->m_done_callback(std::string_view(event->m_text));
+    }
+    // -------------------------------------------------------------------------
+    // process_update
+    // -------------------------------------------------------------------------
+    static void process_update(base::EventData *in_update)
+    {
+      auto *update = (EntryUpdate *) in_update;
+      auto *entry = (EntryData *) update->get_source();
+
+      if (update->m_value_updated)
+      {
+        entry->apply_text(update->m_text);
+        return;
+      }
+    }
+    // -------------------------------------------------------------------------
+    // process_pending_text
+    // -------------------------------------------------------------------------
+    static void process_pending_text(base::EventData *in_update)
+    {
+      auto *entry = (EntryData *) in_update->get_source();
+      entry->m_pending_text.take(&entry->m_applied_text);
+      entry->apply_text(entry->m_applied_text);
+    }
+    // -------------------------------------------------------------------------
+    // apply_text
+    // -------------------------------------------------------------------------
+    // [Note] without the GTK widget (virtualized view) the "changed" event
+    // is queued here instead of by the signal
+    //
+    void apply_text(const std::string &in_text)
+    {
+      m_initial.m_text = in_text;
+      if (m_entry != nullptr)
+      {
+        m_entry->set_text(in_text);
+        return;
+      }
+      queue_text(in_text, process_changed,
+                 m_changed_func != nullptr || m_changed_callback.is_set());
+    }
+
+  private:
+    Gtk::Entry *m_entry;
+    EntryUpdate  m_initial;
+    base::LatestValueSlot<std::string> m_pending_text;
+    std::string m_applied_text;   // (GTK thread) buffer for m_pending_text
+    int m_max_length;
+
+    base::SeqLockString m_text;
+
+    std::string *m_user_text;
+    void *m_user_data;
+    void (*m_changed_func)(void *, std::string);
+    void (*m_done_func)(void *, std::string);
+    base::Callback<void(std::string_view)> m_changed_callback;
+    base::Callback<void(std::string_view)> m_done_callback;
+
+    friend class WindowData;
+    friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  SpinButtonUpdate class
+  // ===========================================================================
+  class SpinButtonUpdate : public base::EventData
+  {
+  protected:
+    // member variables --------------------------------------------------------
+    bool m_value_updated;
+    bool m_range_updated, m_increments_updated;
+    bool m_wrap_updated, m_numeric_updated;
+    bool m_digits_updated;
+    bool m_adjustment_called; // value, lower, upper, step, page, page_size
+    bool m_configure_called;  // climb_rate, digits
+    //
+    double m_value;
+    double m_lower, m_upper;
+    double m_step_increment, m_page_increment;
+    double m_page_size, m_climb_rate;
+    bool m_wrap, m_numeric;
+    guint m_digits;
+
+    // -------------------------------------------------------------------------
+    // SpinButtonUpdate constructor
+    // -------------------------------------------------------------------------
+    SpinButtonUpdate(double in_value,
+                     double in_lower, double in_upper,
+                     double in_step_increment,
+                     double in_page_increment,
+                     double in_page_size,
+                     double in_climb_rate,
+                     guint in_digits,
+                     bool in_wrap, bool in_numeric) :
+            m_value(in_value),
+            m_lower(in_lower), m_upper(in_upper),
+            m_step_increment(in_step_increment), m_page_increment(in_page_increment),
+            m_page_size(in_page_size), m_climb_rate(in_climb_rate),
+            m_digits(in_digits),
+            m_wrap(in_wrap), m_numeric(in_numeric),
+            m_value_updated(true),
+            m_range_updated(true), m_increments_updated(true),
+            m_digits_updated(true),
+            m_wrap_updated(true), m_numeric_updated(true),
+            m_adjustment_called(true),
+            m_configure_called(true),
+            base::EventData(nullptr, nullptr)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // SpinButtonUpdate constructor
+    // -------------------------------------------------------------------------
+    SpinButtonUpdate(WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+            m_value(0),
+            m_lower(0), m_upper(0),
+            m_step_increment(1), m_page_increment(10),
+            m_page_size(0), m_climb_rate(0),
+            m_digits(0),
+            m_wrap(false), m_numeric(false),
+            m_value_updated(false),
+            m_range_updated(false), m_increments_updated(false),
+            m_digits_updated(false),
+            m_wrap_updated(false), m_numeric_updated(false),
+            m_adjustment_called(false),
+            m_configure_called(false),
+            base::EventData(in_source_widget, in_handler)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // SpinButtonUpdate destructor
+    // -------------------------------------------------------------------------
+    ~SpinButtonUpdate() override = default;
+
+    friend class SpinButtonData;
+  };
+
+  // ===========================================================================
+  //  SpinButtonData class (GtkSpinButton)
+  // ===========================================================================
+  class SpinButtonData : public WidgetData
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // get_value
+    // -------------------------------------------------------------------------
+    bool get_value(double *io_value, bool in_compare = false)
+    {
+      if (io_value == nullptr)
+        return false;
+      double value = m_value.load(std::memory_order_acquire);
+      if (in_compare)
+        if (*io_value == value)
+          return false;
+      *io_value = value;
+      return true;
+    }
+#ifdef SHL_GTK_COROUTINE
+    // -------------------------------------------------------------------------
+    // changed
+    // -------------------------------------------------------------------------
+    // "double value = co_await spin->changed()" resumes with the new value on
+    // the executor of the window (see WindowBase::set_executor())
+    //
+    base::ValueAwaiter<double> changed()
+    {
+      return base::ValueAwaiter<double>(&m_changed_awaiters, get_executor());
+    }
+#endif
+    // -------------------------------------------------------------------------
+    // set_number
+    // -------------------------------------------------------------------------
+    bool set_number(double in_value, bool in_invoke_update = true) override
+    {
+      set_value(in_value, in_invoke_update);
+      return true;
+    }
+    // -------------------------------------------------------------------------
+    // set_value
+    // -------------------------------------------------------------------------
+    void set_value(double in_value, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_value = in_value;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_value = in_value;
+      update->m_value_updated = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_adjustment
+    // -------------------------------------------------------------------------
+    void set_adjustment(double in_value,
+                        double in_lower, double in_upper,
+                        double in_step_increment = 1,
+                        double in_page_increment = 10,
+                        double in_page_size = 0,
+                        bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_value = in_value;
+        m_initial.m_lower = in_lower;
+        m_initial.m_upper = in_upper;
+        m_initial.m_step_increment = in_step_increment;
+        m_initial.m_page_increment = in_page_increment;
+        m_initial.m_page_size = in_page_size;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_value = in_value;
+      update->m_lower = in_lower;
+      update->m_upper = in_upper;
+      update->m_step_increment = in_step_increment;
+      update->m_page_increment = in_page_increment;
+      update->m_page_size = in_page_size;
+      update->m_adjustment_called = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_configure
+    // -------------------------------------------------------------------------
+    void set_configure(double in_climb_rate, guint in_digits, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_climb_rate = in_climb_rate;
+        m_initial.m_digits = in_digits;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_climb_rate = in_climb_rate;
+      update->m_digits = in_digits;
+      update->m_configure_called = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_range
+    // -------------------------------------------------------------------------
+    void set_range(double in_lower, guint in_upper, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_lower = in_lower;
+        m_initial.m_upper = in_upper;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_lower = in_lower;
+      update->m_upper = in_upper;
+      update->m_range_updated = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_increments
+    // -------------------------------------------------------------------------
+    void set_increments(double in_step_increment, guint in_page_increment, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_step_increment = in_step_increment;
+        m_initial.m_page_increment = in_page_increment;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_step_increment = in_step_increment;
+      update->m_page_increment = in_page_increment;
+      update->m_increments_updated = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_digits
+    // -------------------------------------------------------------------------
+    void set_digits(guint in_digits, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_digits = in_digits;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_digits = in_digits;
+      update->m_digits_updated = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_wrap
+    // -------------------------------------------------------------------------
+    void set_wrap(bool in_wrap, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_wrap = in_wrap;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_wrap = in_wrap;
+      update->m_wrap_updated = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+    // -------------------------------------------------------------------------
+    // set_numeric
+    // -------------------------------------------------------------------------
+    void set_numeric(bool in_numeric, bool in_invoke_update = true)
+    {
+      if (is_initialized() == false)
+      {
+        m_initial.m_numeric = in_numeric;
+        return;
+      }
+      auto *update = new (get_update_pool()) SpinButtonUpdate(this, process_update);
+      update->m_numeric = in_numeric;
+      update->m_numeric_updated = true;
+      push_update(update);
+      if (in_invoke_update)
+        invoke_update();
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // SpinButtonData constructor
+    // -------------------------------------------------------------------------
+    SpinButtonData( base::WindowBase *in_window,
+                    const char *in_label_str,
+                    double *in_user_variable,
+                    double in_lower, double in_upper,
+                    double in_step_increment = 1,
+                    double in_page_increment = 10,
+                    double in_page_size = 0,
+                    double in_climb_rate = 0,
+                    guint in_digits = 0,
+                    void *in_user_data = nullptr,
+                    void (*in_value_changed_func)(void *, double) = nullptr,
+                    bool in_wrap = false, bool in_numeric = false,
+                    base::EventQueue *in_user_event_queue = nullptr) :
+        WidgetData(in_window, in_label_str, in_user_event_queue),
+        m_user_variable(in_user_variable),
+        m_initial(0, in_lower, in_upper, in_step_increment,
+                      in_page_increment, in_page_size, in_climb_rate,
+                      in_digits, in_wrap, in_numeric),
+        m_user_data(in_user_data),
+        m_value_changed_func(in_value_changed_func),
+        m_spin(nullptr), m_value(0)
+    {
+      if (in_user_variable != nullptr)
+        m_initial.m_value = *in_user_variable;
+    }
+    // -------------------------------------------------------------------------
+    // SpinButtonData destructor
+    // -------------------------------------------------------------------------
+    ~SpinButtonData() override
+    {
+      delete m_spin;
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      Gtk::Box  *box = WidgetData::create();
+      if (box == nullptr)
+        return nullptr;
+      m_spin = new Gtk::SpinButton(
+        Gtk::Adjustment::create(
+                m_initial.m_value,
+                m_initial.m_lower, m_initial.m_upper,
+                m_initial.m_step_increment,
+                m_initial.m_page_increment, m_initial.m_page_size),
+        m_initial.m_climb_rate, m_initial.m_digits);
+      if (m_spin == nullptr)
+        return nullptr;
+      m_spin->set_wrap(m_initial.m_wrap);
+      m_spin->set_numeric(m_initial.m_numeric);
+      m_spin->signal_changed().connect(
+              sigc::mem_fun(*this, &SpinButtonData::queue_value_changed));
+      box->pack_end(*m_spin, Gtk::PACK_SHRINK);
+      return box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    void release() override
+    {
+      m_initial.m_value = m_value.load(std::memory_order_relaxed);
+      delete m_spin;
+      m_spin = nullptr;
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // init_values
+    // -------------------------------------------------------------------------
+    void init_values() override
+    {
+      if (m_user_variable != nullptr)
+        *m_user_variable = m_initial.m_value;
+      m_value.store(m_initial.m_value);
+    }
+    // -------------------------------------------------------------------------
+    // store_snapshot
+    // -------------------------------------------------------------------------
+    void store_snapshot(SnapshotValue *out_value) const override
+    {
+      out_value->m_double = m_value.load(std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    // queue_value_changed
+    // -------------------------------------------------------------------------
+    void queue_value_changed()
+    {
+      store_value(m_spin->get_value());
+    }
+    // -------------------------------------------------------------------------
+    // store_value
+    // -------------------------------------------------------------------------
+    void store_value(double value)
+    {
+      m_value.store(value, std::memory_order_release);
+      mark_as_updated();
+      if (m_value_changed_func != nullptr || m_user_variable != nullptr ||
+          m_changed_callback.is_set())
+      {
+        base::EventValue value_data;
+        value_data.m_double = value;
+        push_value(process_value_changed, value_data);
+      }
+#ifdef SHL_GTK_COROUTINE
+      if (m_changed_awaiters.has_awaiter())
+        m_changed_awaiters.resume_all(value);
+#endif
+    }
+    // -------------------------------------------------------------------------
+    // process_value_changed
+    // -------------------------------------------------------------------------
+    static void process_value_changed(const base::EventRecord &in_record)
+    {
+      auto  *spin = (SpinButtonData *)in_record.m_source;
+      double value = in_record.m_payload.m_double;
+
+      if (spin->m_user_variable != nullptr)
+        *(spin->m_user_variable) = value;
+      if (spin->m_value_changed_func != nullptr)
+        spin->m_value_changed_func(spin->m_user_data, value);
+      if (spin->m_changed_callback)
+        spin->m_changed_callback(value);
+    }
+    // -------------------------------------------------------------------------
+    // process_update
+    // -------------------------------------------------------------------------
+    static void process_update(base::EventData *in_update)
+    {
+      auto *update = (SpinButtonUpdate *)in_update;
+      auto  *spin = (SpinButtonData *)update->get_source();
+
+      bool value_changed = spin->fold_update(update);
+      if (spin->m_spin == nullptr)
+      {
+        // not created (virtualized view): update the value without GTK
+        if (value_changed)
+          spin->store_value(spin->m_initial.m_value);
+        return;
+      }
+      if (update->m_value_updated)
+      {
+        spin->m_spin->set_value(update->m_value);
+        return;
+      }
+      if (update->m_adjustment_called)
+      {
+        spin->m_spin->set_adjustment(Gtk::Adjustment::create(
+                update->m_value,
+                update->m_lower, update->m_upper,
+                update->m_step_increment,
+                update->m_page_increment, update->m_page_size));
+        return;
+      }
+      if (update->m_configure_called)
+      {
+        spin->m_spin->configure(Glib::RefPtr<Gtk::Adjustment>(nullptr),
+                                update->m_climb_rate, update->m_digits);
+        return;
+      }
+      if (update->m_range_updated)
+      {
+        spin->m_spin->set_range(update->m_lower,
+                                update->m_upper);
+        return;
+      }
+      if (update->m_increments_updated)
+      {
+        spin->m_spin->set_increments(update->m_step_increment,
+                                     update->m_page_increment);
+        return;
+      }
+      if (update->m_digits_updated)
+      {
+        spin->m_spin->set_digits(update->m_digits);
+        return;
+      }
+      if (update->m_wrap_updated)
+      {
+        spin->m_spin->set_wrap(update->m_wrap);
+        return;
+      }
+      if (update->m_numeric_updated)
+      {
+        spin->m_spin->set_numeric(update->m_numeric);
+        return;
+      }
+    }
+    // -------------------------------------------------------------------------
+    // fold_update
+    // -------------------------------------------------------------------------
+    // [Note] applies in_update to m_initial (so that create() can restore it)
+    // and returns true if the (clamped) value differs from the current one
+    //
+    bool fold_update(const SpinButtonUpdate *in_update)
+    {
+      if (in_update->m_value_updated)
+        m_initial.m_value = in_update->m_value;
+      else if (in_update->m_adjustment_called)
+      {
+        m_initial.m_value = in_update->m_value;
+        m_initial.m_lower = in_update->m_lower;
+        m_initial.m_upper = in_update->m_upper;
+        m_initial.m_step_increment = in_update->m_step_increment;
+        m_initial.m_page_increment = in_update->m_page_increment;
+        m_initial.m_page_size = in_update->m_page_size;
+      }
+      else if (in_update->m_configure_called)
+      {
+        m_initial.m_climb_rate = in_update->m_climb_rate;
+        m_initial.m_digits = in_update->m_digits;
+      }
+      else if (in_update->m_range_updated)
+      {
+        m_initial.m_lower = in_update->m_lower;
+        m_initial.m_upper = in_update->m_upper;
+      }
+      else if (in_update->m_increments_updated)
+      {
+        m_initial.m_step_increment = in_update->m_step_increment;
+        m_initial.m_page_increment = in_update->m_page_increment;
+      }
+      else if (in_update->m_digits_updated)
+        m_initial.m_digits = in_update->m_digits;
+      else if (in_update->m_wrap_updated)
+        m_initial.m_wrap = in_update->m_wrap;
+      else if (in_update->m_numeric_updated)
+        m_initial.m_numeric = in_update->m_numeric;
+      if (m_initial.m_lower <= m_initial.m_upper)
+        m_initial.m_value = std::min(std::max(m_initial.m_value, m_initial.m_lower),
+                                     m_initial.m_upper);
+      return m_initial.m_value != m_value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    Gtk::SpinButton *m_spin;
+    SpinButtonUpdate  m_initial;
+
+    std::atomic<double> m_value;
+#ifdef SHL_GTK_COROUTINE
+    base::AwaiterList<double> m_changed_awaiters;
+#endif
+
+    double *m_user_variable;
+    void *m_user_data;
+    void (*m_value_changed_func)(void *, double);
+    base::Callback<void(double)> m_changed_callback;
+
+    friend class WindowData;
+    friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  SwitchUpdate class
+  // ===========================================================================
+  class SwitchUpdate : public base::EventData
+  {
+  protected:
+      // member variables --------------------------------------------------------
+      bool m_value_updated;
+      bool m_value;
+
+      // -------------------------------------------------------------------------
+      // SwitchUpdate constructor
+      // -------------------------------------------------------------------------
+      SwitchUpdate(bool in_value,
+                   WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+          m_value(in_value),
+          m_value_updated(true),
+          base::EventData(in_source_widget, in_handler)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // SwitchUpdate destructor
+      // -------------------------------------------------------------------------
+      ~SwitchUpdate() override = default;
+
+      friend class SwitchData;
+  };
+
+  // ===========================================================================
+  //  SwitchData class (GtkSwitch)
+  // ===========================================================================
+  class SwitchData : public WidgetData
+  {
+  public:
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // get_value
+      // -------------------------------------------------------------------------
+      bool get_value(bool *io_value, bool in_compare = false)
+      {
+        if (io_value == nullptr)
+          return false;
+        bool value = m_value.load(std::memory_order_acquire);
+        if (in_compare)
+          if (*io_value == value)
+            return false;
+        *io_value = value;
+        return true;
+      }
+      // -------------------------------------------------------------------------
+      // set_number
+      // -------------------------------------------------------------------------
+      bool set_number(double in_value, bool in_invoke_update = true) override
+      {
+        set_value(in_value != 0.0, in_invoke_update);
+        return true;
+      }
+      // -------------------------------------------------------------------------
+      // set_value
+      // -------------------------------------------------------------------------
+      void set_value(bool in_value, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_value = in_value;
+          return;
+        }
+        auto *update = new (get_update_pool()) SwitchUpdate(in_value, this, process_update);
+        push_update(update);
+        if (in_invoke_update)
+          invoke_update();
+      }
+
+  protected:
+      // -------------------------------------------------------------------------
+      // SwitchData destructor
+      // -------------------------------------------------------------------------
+      ~SwitchData() override
+      {
+        delete m_switch;
+      }
+
+      // -------------------------------------------------------------------------
+      // SwitchData constructor
+      // -------------------------------------------------------------------------
+      SwitchData(base::WindowBase *in_window,
+                 const char *in_label_str,
+                 bool *in_user_variable,
+                 void *in_user_data = nullptr,
+                 void (*in_toggled_func)(void *in_user_data) = nullptr,
+                 base::EventQueue *in_user_event_queue = nullptr) :
+          WidgetData(in_window, in_label_str, in_user_event_queue),
+          m_user_variable(in_user_variable),
+          m_initial(false, nullptr, nullptr),
+          m_user_data(in_user_data),
+          m_toggled_func(in_toggled_func),
+          m_switch(nullptr), m_value(false)
+      {
+        if (in_user_variable != nullptr)
+          m_initial.m_value = *in_user_variable;
+      }
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // create
+      // -------------------------------------------------------------------------
+      Gtk::Box *create() override
+      {
+        Gtk::Box  *box = WidgetData::create();
+        if (box == nullptr)
+          return nullptr;
+        m_switch = new Gtk::Switch();
+        if (m_switch == nullptr)
+          return nullptr;
+        m_switch->set_active(m_initial.m_value);
+        m_switch->signal_state_set().connect(
+            sigc::mem_fun(*this, &SwitchData::queue_state_set));
+        box->pack_end(*m_switch, Gtk::PACK_SHRINK);
+        return box;
+      }
+      // -------------------------------------------------------------------------
+      // release
+      // -------------------------------------------------------------------------
+      void release() override
+      {
+        m_initial.m_value = m_value.load(std::memory_order_relaxed);
+        delete m_switch;
+        m_switch = nullptr;
+        WidgetData::release();
+      }
+      // -------------------------------------------------------------------------
+      // init_values
+      // -------------------------------------------------------------------------
+      void init_values() override
+      {
+        if (m_user_variable != nullptr)
+          *m_user_variable = m_initial.m_value;
+        m_value.store(m_initial.m_value);
+      }
+      // -------------------------------------------------------------------------
+      // store_snapshot
+      // -------------------------------------------------------------------------
+      void store_snapshot(SnapshotValue *out_value) const override
+      {
+        out_value->m_bool = m_value.load(std::memory_order_relaxed);
+      }
+      // -------------------------------------------------------------------------
+      // queue_state_set
+      // -------------------------------------------------------------------------
+      bool queue_state_set(bool inState)
+      {
+        m_value.store(inState, std::memory_order_release);
+        mark_as_updated();
+        if (m_toggled_func == nullptr && m_user_variable == nullptr)
+          return false;
+        base::EventValue value_data;
+        value_data.m_bool = inState;
+        push_value(process_state_set, value_data);
+        return false;
+      }
+      // -------------------------------------------------------------------------
+      // process_state_set
+      // -------------------------------------------------------------------------
+      static void process_state_set(const base::EventRecord &in_record)
+      {
+        auto  *button = (SwitchData *)in_record.m_source;
+        if (button->m_user_variable != nullptr)
+          *(button->m_user_variable) = in_record.m_payload.m_bool;
+        if (button->m_toggled_func != nullptr)
+          button->m_toggled_func(button->m_user_data);
+      }
+      // -------------------------------------------------------------------------
+      // process_update
+      // -------------------------------------------------------------------------
+      static void process_update(base::EventData *in_update)
+      {
+        auto *update = (SwitchUpdate *) in_update;
+        auto *button = (SwitchData *) update->get_source();
+
+        if (update->m_value_updated)
+        {
+          button->m_initial.m_value = update->m_value;
+          if (button->m_switch != nullptr)
+            button->m_switch->set_active(update->m_value);
+          else if (button->m_value.load(std::memory_order_relaxed) != update->m_value)
+            button->queue_state_set(update->m_value);   // (virtualized view)
+          return;
+        }
+      }
+
+  private:
+      // member variables --------------------------------------------------------
+      Gtk::Switch *m_switch;
+      SwitchUpdate  m_initial;
+
+      std::atomic<bool> m_value;
+
+      bool *m_user_variable;
+      void *m_user_data;
+      void (*m_toggled_func)(void *in_user_data);
+
+      friend class WindowData;
+      friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  ComboBoxUpdate class
+  // ===========================================================================
+  class ComboBoxUpdate : public base::EventData
+  {
+  protected:
+      // member variables --------------------------------------------------------
+      bool m_value_updated;
+      int m_value;
+
+      // -------------------------------------------------------------------------
+      // ComboBoxUpdate constructor
+      // -------------------------------------------------------------------------
+      ComboBoxUpdate(int in_value,
+                     WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+          m_value(in_value),
+          m_value_updated(true),
+          base::EventData(in_source_widget, in_handler)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // ComboBoxUpdate destructor
+      // -------------------------------------------------------------------------
+      ~ComboBoxUpdate() override = default;
+
+      friend class ComboBoxData;
+  };
+
+  // ===========================================================================
+  //  ComboBoxData class (GtkComboBox)
+  // ===========================================================================
+  class ComboBoxData : public WidgetData
+  {
+  public:
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // get_value
+      // -------------------------------------------------------------------------
+      bool get_value(int *io_value, bool in_compare = false)
+      {
+        if (io_value == nullptr)
+          return false;
+        int value = m_value.load(std::memory_order_acquire);
+        if (in_compare)
+          if (*io_value == value)
+            return false;
+        *io_value = value;
+        return true;
+      }
+      // -------------------------------------------------------------------------
+      // set_number
+      // -------------------------------------------------------------------------
+      bool set_number(double in_value, bool in_invoke_update = true) override
+      {
+        set_value((int)std::lround(in_value), in_invoke_update);
+        return true;
+      }
+      // -------------------------------------------------------------------------
+      // set_value
+      // -------------------------------------------------------------------------
+      void set_value(int in_value, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_value = in_value;
+          return;
+        }
+        auto *update = new (get_update_pool()) ComboBoxUpdate(in_value, this, process_update);
+        push_update(update);
+        if (in_invoke_update)
+          invoke_update();
+      }
+
+  protected:
+      // -------------------------------------------------------------------------
+      // ComboBoxData destructor
+      // -------------------------------------------------------------------------
+      ~ComboBoxData() override
+      {
+        delete m_combo_box;
+      }
+
+      // -------------------------------------------------------------------------
+      // ComboBoxData constructor
+      // -------------------------------------------------------------------------
+      ComboBoxData(base::WindowBase *in_window,
+                   const char *in_label_str,
+                   const std::vector<std::string> &in_items,
+                   int *in_user_variable,
+                   void *in_user_data = nullptr,
+                   void (*in_changed_func)(void *in_user_data) = nullptr,
+                   base::EventQueue *in_user_event_queue = nullptr) :
+          WidgetData(in_window, in_label_str, in_user_event_queue),
+          m_user_variable(in_user_variable),
+          m_items(in_items),
+          m_initial(0, nullptr, nullptr),
+          m_user_data(in_user_data),
+          m_changed_func(in_changed_func),
+          m_combo_box(nullptr), m_value(0)
+      {
+        if (in_user_variable != nullptr)
+          m_initial.m_value = *in_user_variable;
+      }
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // create
+      // -------------------------------------------------------------------------
+      Gtk::Box *create() override
+      {
+        Gtk::Box  *box = WidgetData::create();
+        if (box == nullptr)
+          return nullptr;
+        m_combo_box = new Gtk::ComboBoxText();
+        if (m_combo_box == nullptr)
+          return nullptr;
+        for (auto it = m_items.begin(); it != m_items.end(); it++)
+          m_combo_box->append((*it));
+        m_combo_box->set_active(m_initial.m_value);
+        m_combo_box->signal_changed().connect(
+            sigc::mem_fun(*this, &ComboBoxData::queue_changed));
+        box->pack_end(*m_combo_box, Gtk::PACK_SHRINK);
+        return box;
+      }
+      // -------------------------------------------------------------------------
+      // release
+      // -------------------------------------------------------------------------
+      void release() override
+      {
+        m_initial.m_value = m_value.load(std::memory_order_relaxed);
+        delete m_combo_box;
+        m_combo_box = nullptr;
+        WidgetData::release();
+      }
+      // -------------------------------------------------------------------------
+      // init_values
+      // -------------------------------------------------------------------------
+      void init_values() override
+      {
+        if (m_user_variable != nullptr)
+          *m_user_variable = m_initial.m_value;
+        m_value.store(m_initial.m_value);
+      }
+      // -------------------------------------------------------------------------
+      // store_snapshot
+      // -------------------------------------------------------------------------
+      void store_snapshot(SnapshotValue *out_value) const override
+      {
+        out_value->m_int = m_value.load(std::memory_order_relaxed);
+      }
+      // -------------------------------------------------------------------------
+      // queue_changed
+      // -------------------------------------------------------------------------
+      void queue_changed()
+      {
+        store_value(m_combo_box->get_active_row_number());
+      }
+      // -------------------------------------------------------------------------
+      // store_value
+      // -------------------------------------------------------------------------
+      void store_value(int value)
+      {
+        m_value.store(value, std::memory_order_release);
+        mark_as_updated();
+        if (m_changed_func == nullptr && m_user_variable == nullptr)
+          return;
+        base::EventValue value_data;
+        value_data.m_int = value;
+        push_value(process_changed, value_data);
+      }
+      // -------------------------------------------------------------------------
+      // process_changed
+      // -------------------------------------------------------------------------
+      static void process_changed(const base::EventRecord &in_record)
+      {
+        auto  *button = (ComboBoxData *)in_record.m_source;
+        if (button->m_user_variable != nullptr)
+          *(button->m_user_variable) = (int)in_record.m_payload.m_int;
+        if (button->m_changed_func != nullptr)
+          button->m_changed_func(button->m_user_data);
+      }
+      // -------------------------------------------------------------------------
+      // process_update
+      // -------------------------------------------------------------------------
+      static void process_update(base::EventData *in_update)
+      {
+        auto *update = (ComboBoxUpdate *) in_update;
+        auto *button = (ComboBoxData *) update->get_source();
+
+        if (update->m_value_updated)
+        {
+          button->m_initial.m_value = update->m_value;
+          if (button->m_combo_box != nullptr)
+            button->m_combo_box->set_active(update->m_value);
+          else if (button->m_value.load(std::memory_order_relaxed) != update->m_value)
+            button->store_value(update->m_value);   // (virtualized view)
+          return;
+        }
+      }
+
+  private:
+      // member variables --------------------------------------------------------
+      Gtk::ComboBoxText *m_combo_box;
+      ComboBoxUpdate  m_initial;
+
+      std::atomic<int> m_value;
+      std::vector<std::string>  m_items;
+
+      int *m_user_variable;
+      void *m_user_data;
+      void (*m_changed_func)(void *in_user_data);
+
+      friend class WindowData;
+      friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  ScaleUpdate class
+  // ===========================================================================
+  class ScaleUpdate : public base::EventData
+  {
+  protected:
+      // member variables --------------------------------------------------------
+      bool m_value_updated;
+      bool m_range_updated, m_increments_updated;
+      bool m_digits_updated;
+      bool m_adjustment_called; // value, lower, upper, step, page, page_size
+      //
+      double m_value;
+      double m_lower, m_upper;
+      double m_step_increment, m_page_increment;
+      double m_page_size;
+      int m_digits;
+
+      // -------------------------------------------------------------------------
+      // ScaleUpdate constructor
+      // -------------------------------------------------------------------------
+      ScaleUpdate(double in_value,
+                  double in_lower, double in_upper,
+                  double in_step_increment,
+                  double in_page_increment,
+                  double in_page_size,
+                  int in_digits) :
+          m_value(in_value),
+          m_lower(in_lower), m_upper(in_upper),
+          m_step_increment(in_step_increment), m_page_increment(in_page_increment),
+          m_page_size(in_page_size),
+          m_digits(in_digits),
+          m_value_updated(true),
+          m_range_updated(true), m_increments_updated(true),
+          m_digits_updated(true),
+          m_adjustment_called(true),
+          base::EventData(nullptr, nullptr)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // ScaleUpdate constructor
+      // -------------------------------------------------------------------------
+      ScaleUpdate(WidgetData *in_source_widget, void (*in_handler)(base::EventData *)) :
+          m_value(0),
+          m_lower(0), m_upper(0),
+          m_step_increment(1), m_page_increment(10),
+          m_page_size(0),
+          m_digits(0),
+          m_value_updated(false),
+          m_range_updated(false), m_increments_updated(false),
+          m_digits_updated(false),
+          m_adjustment_called(false),
+          base::EventData(in_source_widget, in_handler)
+      {
+      }
+      // -------------------------------------------------------------------------
+      // ScaleUpdate destructor
+      // -------------------------------------------------------------------------
+      ~ScaleUpdate() override = default;
+
+      friend class ScaleData;
+  };
+
+  // ===========================================================================
+  //  ScaleData class (GtkScale)
+  // ===========================================================================
+  class ScaleData : public WidgetData
+  {
+  public:
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // get_value
+      // -------------------------------------------------------------------------
+      bool get_value(double *io_value, bool in_compare = false)
+      {
+        if (io_value == nullptr)
+          return false;
+        double value = m_value.load(std::memory_order_acquire);
+        if (in_compare)
+          if (*io_value == value)
+            return false;
+        *io_value = value;
+        return true;
+      }
+      // -------------------------------------------------------------------------
+      // set_number
+      // -------------------------------------------------------------------------
+      bool set_number(double in_value, bool in_invoke_update = true) override
+      {
+        set_value(in_value, in_invoke_update);
+        return true;
+      }
+      // -------------------------------------------------------------------------
+      // set_value
+      // -------------------------------------------------------------------------
+      void set_value(double in_value, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_value = in_value;
+          return;
+        }
+        if (is_latest_value_only())
+        {
+          if (m_pending_value.store(in_value) == false)
+            return;   // the queued update applies the new value
+          push_update(process_pending_value);
+        }
+        else
+        {
+          auto *update = new (get_update_pool()) ScaleUpdate(this, process_update);
+          update->m_value = in_value;
+          update->m_value_updated = true;
+          push_update(update);
+        }
+        if (in_invoke_update)
+          invoke_update();
+      }
+      // -------------------------------------------------------------------------
+      // set_adjustment
+      // -------------------------------------------------------------------------
+      void set_adjustment(double in_value,
+                          double in_lower, double in_upper,
+                          double in_step_increment = 1,
+                          double in_page_increment = 10,
+                          double in_page_size = 0,
+                          bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
           m_initial.m_value = in_value;
+          m_initial.m_lower = in_lower;
+          m_initial.m_upper = in_upper;
+          m_initial.m_step_increment = in_step_increment;
+          m_initial.m_page_increment = in_page_increment;
+          m_initial.m_page_size = in_page_size;
           return;
         }
-        auto *update = new ScaleUpdate(this, process_update);
+        auto *update = new (get_update_pool()) ScaleUpdate(this, process_update);
         update->m_value = in_value;
-        update->m_value_updated = true;
+        update->m_lower = in_lower;
+        update->m_upper = in_upper;
+        update->m_step_increment = in_step_increment;
+        update->m_page_increment = in_page_increment;
+        update->m_page_size = in_page_size;
+        update->m_adjustment_called = true;
+        push_update(update);
+        if (in_invoke_update)
+          invoke_update();
+      }
+      // -------------------------------------------------------------------------
+      // set_digits
+      // -------------------------------------------------------------------------
+      void set_digits(int in_digits, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_digits = in_digits;
+          return;
+        }
+        auto *update = new (get_update_pool()) ScaleUpdate(this, process_update);
+        update->m_digits = in_digits;
+        update->m_digits_updated = true;
+        push_update(update);
+        if (in_invoke_update)
+          invoke_update();
+      }
+      // -------------------------------------------------------------------------
+      // set_range
+      // -------------------------------------------------------------------------
+      void set_range(double in_lower, guint in_upper, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_lower = in_lower;
+          m_initial.m_upper = in_upper;
+          return;
+        }
+        auto *update = new (get_update_pool()) ScaleUpdate(this, process_update);
+        update->m_lower = in_lower;
+        update->m_upper = in_upper;
+        update->m_range_updated = true;
+        push_update(update);
+        if (in_invoke_update)
+          invoke_update();
+      }
+      // -------------------------------------------------------------------------
+      // set_increments
+      // -------------------------------------------------------------------------
+      void set_increments(double in_step_increment, guint in_page_increment, bool in_invoke_update = true)
+      {
+        if (is_initialized() == false)
+        {
+          m_initial.m_step_increment = in_step_increment;
+          m_initial.m_page_increment = in_page_increment;
+          return;
+        }
+        auto *update = new (get_update_pool()) ScaleUpdate(this, process_update);
+        update->m_step_increment = in_step_increment;
+        update->m_page_increment = in_page_increment;
+        update->m_increments_updated = true;
         push_update(update);
         if (in_invoke_update)
           invoke_update();
       }
+
+  protected:
+      // -------------------------------------------------------------------------
+      // ScaleData constructor
+      // -------------------------------------------------------------------------
+      ScaleData( base::WindowBase *in_window,
+                 const char *in_label_str,
+                 double *in_user_variable,
+                 double in_lower, double in_upper,
+                 double in_step_increment = 1,
+                 double in_page_increment = 10,
+                 double in_page_size = 0,
+                 int in_digits = 0,
+                 void *in_user_data = nullptr,
+                 void (*in_value_changed_func)(void *, double) = nullptr,
+                 base::EventQueue *in_user_event_queue = nullptr) :
+          WidgetData(in_window, in_label_str, in_user_event_queue),
+          m_user_variable(in_user_variable),
+          m_initial(0, in_lower, in_upper, in_step_increment,
+                    in_page_increment, in_page_size, in_digits),
+          m_user_data(in_user_data),
+          m_value_changed_func(in_value_changed_func),
+          m_scale(nullptr), m_value(0)
+      {
+        if (in_user_variable != nullptr)
+          m_initial.m_value = *in_user_variable;
+      }
+      // -------------------------------------------------------------------------
+      // ScaleData destructor
+      // -------------------------------------------------------------------------
+      ~ScaleData() override
+      {
+        delete m_scale;
+      }
+
+      // Member functions --------------------------------------------------------
+      // -------------------------------------------------------------------------
+      // create
+      // -------------------------------------------------------------------------
+      Gtk::Box *create() override
+      {
+        Gtk::Box  *box = WidgetData::create();
+        if (box == nullptr)
+          return nullptr;
+        m_scale = new Gtk::Scale(
+            Gtk::Adjustment::create(
+                m_initial.m_value,
+                m_initial.m_lower, m_initial.m_upper,
+                m_initial.m_step_increment,
+                m_initial.m_page_increment, m_initial.m_page_size));
+        if (m_scale == nullptr)
+          return nullptr;
+        m_scale->set_digits(m_initial.m_digits);
+        m_scale->signal_value_changed().connect(
+            sigc::mem_fun(*this, &ScaleData::queue_value_changed));
+        box->pack_end(*m_scale, Gtk::PACK_EXPAND_WIDGET);
+        return box;
+      }
+      // -------------------------------------------------------------------------
+      // release
+      // -------------------------------------------------------------------------
+      void release() override
+      {
+        m_initial.m_value = m_value.load(std::memory_order_relaxed);
+        delete m_scale;
+        m_scale = nullptr;
+        WidgetData::release();
+      }
       // -------------------------------------------------------------------------
-      // set_adjustment
+      // init_values
       // -------------------------------------------------------------------------
-      void set_adjustment(double in_value,
-                          double in_lower, double in_upper,
-                          double in_step_increment = 1,
-                          double in_page_increment = 10,
-                          double in_page_size = 0,
-                          bool in_invoke_update = true)
+      void init_values() override
       {
-        if (m_scale == nullptr)
-        {
-          m_initial.m_value = in_value;
-          m_initial.m_lower = in_lower;
-          m_initial.m_upper = in_upper;
-          m_initial.m_step_increment = in_step_increment;
-          m_initial.m_page_increment = in_page_increment;
-          m_initial.m_page_size = in_page_size;
-          return;
-        }
-        auto *update = new ScaleUpdate(this, process_update);
-        update->m_value = in_value;
-        update->m_lower = in_lower;
-        update->m_upper = in_upper;
-        update->m_step_increment = in_step_increment;
-        update->m_page_increment = in_page_increment;
-        update->m_page_size = in_page_size;
-        update->m_adjustment_called = true;
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
+        if (m_user_variable != nullptr)
+          *m_user_variable = m_initial.m_value;
+        m_value.store(m_initial.m_value);
       }
       // -------------------------------------------------------------------------
-      // set_digits
+      // store_snapshot
       // -------------------------------------------------------------------------
-      void set_digits(int in_digits, bool in_invoke_update = true)
+      void store_snapshot(SnapshotValue *out_value) const override
       {
-        if (m_scale == nullptr)
-        {
-          m_initial.m_digits = in_digits;
+        out_value->m_double = m_value.load(std::memory_order_relaxed);
+      }
+      // -------------------------------------------------------------------------
+      // queue_value_changed
+      // -------------------------------------------------------------------------
+      void queue_value_changed()
+      {
+        store_value(m_scale->get_value());
+      }
+      // -------------------------------------------------------------------------
+      // store_value
+      // -------------------------------------------------------------------------
+      void store_value(double value)
+      {
+        m_value.store(value, std::memory_order_release);
+        mark_as_updated();
+        if (m_value_changed_func == nullptr && m_user_variable == nullptr &&
+            m_changed_callback.is_set() == false)
           return;
-        }
-        auto *update = new ScaleUpdate(this, process_update);
-        update->m_digits = in_digits;
-        update->m_digits_updated = true;
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
+        base::EventValue value_data;
+        value_data.m_double = value;
+        push_value(process_value_changed, value_data);
       }
       // -------------------------------------------------------------------------
-      // set_range
+      // process_value_changed
       // -------------------------------------------------------------------------
-      void set_range(double in_lower, guint in_upper, bool in_invoke_update = true)
+      static void process_value_changed(const base::EventRecord &in_record)
       {
-        if (m_scale == nullptr)
+        auto  *spin = (ScaleData *)in_record.m_source;
+        double value = in_record.m_payload.m_double;
+
+        if (spin->m_user_variable != nullptr)
+          *(spin->m_user_variable) = value;
+        if (spin->m_value_changed_func != nullptr)
+          spin->m_value_changed_func(spin->m_user_data, value);
+        if (spin->m_changed_callback)
+          spin->m_changed_callback(value);
+      }
+      // -------------------------------------------------------------------------
+      // process_update
+      // -------------------------------------------------------------------------
+      static void process_update(base::EventData *in_update)
+      {
+        auto *update = (ScaleUpdate *)in_update;
+        auto  *spin = (ScaleData *)update->get_source();
+
+        bool value_changed = spin->fold_update(update);
+        if (spin->m_scale == nullptr)
         {
-          m_initial.m_lower = in_lower;
-          m_initial.m_upper = in_upper;
+          // not created (virtualized view): update the value without GTK
+          if (value_changed)
+            spin->store_value(spin->m_initial.m_value);
+          return;
+        }
+        if (update->m_value_updated)
+        {
+          spin->m_scale->set_value(update->m_value);
+          return;
+        }
+        if (update->m_adjustment_called)
+        {
+          spin->m_scale->set_adjustment(Gtk::Adjustment::create(
+              update->m_value,
+              update->m_lower, update->m_upper,
+              update->m_step_increment,
+              update->m_page_increment, update->m_page_size));
+          return;
+        }
+        if (update->m_digits_updated)
+        {
+          spin->m_scale->set_digits(update->m_digits);
+          return;
+        }
+        if (update->m_range_updated)
+        {
+          spin->m_scale->set_range(update->m_lower,
+                                   update->m_upper);
+          return;
+        }
+        if (update->m_increments_updated)
+        {
+          spin->m_scale->set_increments(update->m_step_increment,
+                                        update->m_page_increment);
           return;
         }
-        auto *update = new ScaleUpdate(this, process_update);
-        update->m_lower = in_lower;
-        update->m_upper = in_upper;
-        update->m_range_updated = true;
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
       }
       // -------------------------------------------------------------------------
-      // set_increments
+      // process_pending_value
       // -------------------------------------------------------------------------
-      void set_increments(double in_step_increment, guint in_page_increment, bool in_invoke_update = true)
+      static void process_pending_value(base::EventData *in_update)
+      {
+        auto *scale = (ScaleData *) in_update->get_source();
+        ScaleUpdate update(scale, nullptr);
+        scale->m_pending_value.take(&update.m_value);
+        update.m_value_updated = true;
+        process_update(&update);
+      }
+      // -------------------------------------------------------------------------
+      // fold_update
+      // -------------------------------------------------------------------------
+      // [Note] applies in_update to m_initial (so that create() can restore it)
+      // and returns true if the (clamped) value differs from the current one
+      //
+      bool fold_update(const ScaleUpdate *in_update)
+      {
+        if (in_update->m_value_updated)
+          m_initial.m_value = in_update->m_value;
+        else if (in_update->m_adjustment_called)
+        {
+          m_initial.m_value = in_update->m_value;
+          m_initial.m_lower = in_update->m_lower;
+          m_initial.m_upper = in_update->m_upper;
+          m_initial.m_step_increment = in_update->m_step_increment;
+          m_initial.m_page_increment = in_update->m_page_increment;
+          m_initial.m_page_size = in_update->m_page_size;
+        }
+        else if (in_update->m_digits_updated)
+          m_initial.m_digits = in_update->m_digits;
+        else if (in_update->m_range_updated)
+        {
+          m_initial.m_lower = in_update->m_lower;
+          m_initial.m_upper = in_update->m_upper;
+        }
+        else if (in_update->m_increments_updated)
+        {
+          m_initial.m_step_increment = in_update->m_step_increment;
+          m_initial.m_page_increment = in_update->m_page_increment;
+        }
+        if (m_initial.m_lower <= m_initial.m_upper)
+          m_initial.m_value = std::min(std::max(m_initial.m_value, m_initial.m_lower),
+                                       m_initial.m_upper);
+        return m_initial.m_value != m_value.load(std::memory_order_relaxed);
+      }
+
+  private:
+      Gtk::Scale *m_scale;
+      ScaleUpdate  m_initial;
+      base::LatestValueSlot<double> m_pending_value;
+
+      std::atomic<double> m_value;
+
+      double *m_user_variable;
+      void *m_user_data;
+      void (*m_value_changed_func)(void *, double);
+      base::Callback<void(double)> m_changed_callback;
+
+      friend class WindowData;
+      friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  PlotData class (GtkDrawingArea)
+  // ===========================================================================
+  // Strip chart of one or more channels. The producer pushes samples into a
+  // per-channel SampleRing (no lock, no event per sample) and the drawing
+  // area is redrawn at most once per frame while new samples arrive. Each
+  // pixel column shows the min/max of the samples that fall into it.
+  //
+  class PlotData : public WidgetData
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // push_sample
+    // -------------------------------------------------------------------------
+    // [Note] one producer thread per channel
+    //
+    void push_sample(size_t in_channel, float in_sample)
+    {
+      if (in_channel < m_channels.size())
+        m_channels[in_channel]->push(in_sample);
+    }
+    // -------------------------------------------------------------------------
+    // push_samples
+    // -------------------------------------------------------------------------
+    void push_samples(size_t in_channel, const float *in_samples, size_t in_num)
+    {
+      if (in_channel < m_channels.size())
+        m_channels[in_channel]->push(in_samples, in_num);
+    }
+    // -------------------------------------------------------------------------
+    // get_channel_num
+    // -------------------------------------------------------------------------
+    size_t get_channel_num() const
+    {
+      return m_channels.size();
+    }
+    // -------------------------------------------------------------------------
+    // set_range
+    // -------------------------------------------------------------------------
+    void set_range(double in_lower, double in_upper)
+    {
+      m_lower.store(in_lower);
+      m_upper.store(in_upper);
+      m_range_changed.store(true);  // redraw on the next frame
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // PlotData constructor
+    // -------------------------------------------------------------------------
+    PlotData(base::WindowBase *in_window,
+             const char *in_label_str,
+             size_t in_channel_num,
+             size_t in_history_size,
+             double in_lower, double in_upper,
+             int in_height,
+             base::EventQueue *in_user_event_queue = nullptr) :
+        WidgetData(in_window, in_label_str, in_user_event_queue),
+        m_area(nullptr),
+        m_history_size(std::max<size_t>(in_history_size, 2)),
+        m_height(in_height),
+        m_lower(in_lower), m_upper(in_upper),
+        m_range_changed(false),
+        m_tick_id(0),
+        m_drawn_head(0)
+    {
+      for (size_t i = 0; i < std::max<size_t>(in_channel_num, 1); i++)
+        m_channels.push_back(new base::SampleRing(m_history_size * 2));  // (slack for the producer)
+      m_samples.resize(m_history_size);
+    }
+    // -------------------------------------------------------------------------
+    // PlotData destructor
+    // -------------------------------------------------------------------------
+    ~PlotData() override
+    {
+      delete m_area;
+      for (auto it = m_channels.begin(); it != m_channels.end(); it++)
+        delete (*it);
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      Gtk::Box  *box = WidgetData::create();
+      if (box == nullptr)
+        return nullptr;
+      m_area = new Gtk::DrawingArea();
+      if (m_area == nullptr)
+        return nullptr;
+      m_area->set_size_request(-1, m_height);
+      m_area->set_hexpand(true);
+      m_area->signal_draw().connect(sigc::mem_fun(*this, &PlotData::on_draw));
+      m_area->signal_map().connect(sigc::mem_fun(*this, &PlotData::on_map));
+      m_area->signal_unmap().connect(sigc::mem_fun(*this, &PlotData::on_unmap));
+      box->pack_end(*m_area, Gtk::PACK_EXPAND_WIDGET);
+      return box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    void release() override
+    {
+      on_unmap();
+      delete m_area;
+      m_area = nullptr;
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // get_row_height
+    // -------------------------------------------------------------------------
+    int get_row_height(int in_row_height) const override
+    {
+      return std::max(in_row_height, m_height + 4); // (+ the row margins)
+    }
+    // -------------------------------------------------------------------------
+    // on_map
+    // -------------------------------------------------------------------------
+    // [Note] the frame clock tick only runs while the plot is visible
+    //
+    void on_map()
+    {
+      if (m_tick_id == 0)
+        m_tick_id = m_area->add_tick_callback(sigc::mem_fun(*this, &PlotData::on_tick));
+    }
+    // -------------------------------------------------------------------------
+    // on_unmap
+    // -------------------------------------------------------------------------
+    void on_unmap()
+    {
+      if (m_tick_id != 0)
+        m_area->remove_tick_callback(m_tick_id);
+      m_tick_id = 0;
+    }
+    // -------------------------------------------------------------------------
+    // on_tick
+    // -------------------------------------------------------------------------
+    bool on_tick(const Glib::RefPtr<Gdk::FrameClock> &in_frame_clock)
+    {
+      uint64_t head = 0;
+      for (auto it = m_channels.begin(); it != m_channels.end(); it++)
+        head += (*it)->get_head();
+      if (head != m_drawn_head || m_range_changed.exchange(false))
+      {
+        m_drawn_head = head;
+        m_area->queue_draw();
+      }
+      return true;
+    }
+    // -------------------------------------------------------------------------
+    // on_draw
+    // -------------------------------------------------------------------------
+    bool on_draw(const Cairo::RefPtr<Cairo::Context> &in_context)
+    {
+      static const double s_colors[][3] = {
+        {0.20, 0.47, 0.85}, {0.90, 0.38, 0.00}, {0.20, 0.65, 0.30},
+        {0.80, 0.15, 0.25}, {0.55, 0.35, 0.75}, {0.45, 0.45, 0.45}
+      };
+      const int width = m_area->get_allocated_width();
+      const int height = m_area->get_allocated_height();
+      const double lower = m_lower.load();
+      const double upper = m_upper.load();
+      const double scale = (upper != lower) ? (height - 1) / (upper - lower) : 0.0;
+      in_context->set_source_rgb(1.0, 1.0, 1.0);
+      in_context->paint();
+      if (width <= 0 || height <= 0)
+        return true;
+      m_column_min.resize(width);
+      m_column_max.resize(width);
+      in_context->set_line_width(1.0);
+      for (size_t ch = 0; ch < m_channels.size(); ch++)
+      {
+        size_t num = m_channels[ch]->read_latest(m_samples.data(), m_history_size);
+        if (num < 2)
+          continue;
+        const double *color = s_colors[ch % (sizeof(s_colors) / sizeof(s_colors[0]))];
+        in_context->set_source_rgb(color[0], color[1], color[2]);
+        if (num <= (size_t)width)
+        {
+          // fewer samples than pixels: a plain polyline
+          for (size_t i = 0; i < num; i++)
+          {
+            double x = (double)i * (width - 1) / (num - 1);
+            double y = height - 1 - (m_samples[i] - lower) * scale;
+            if (i == 0)
+              in_context->move_to(x, y);
+            else
+              in_context->line_to(x, y);
+          }
+        }
+        else
+        {
+          base::SampleRing::decimate_min_max(m_samples.data(), num, width,
+                                             m_column_min.data(), m_column_max.data());
+          for (int x = 0; x < width; x++)
+          {
+            double y_min = height - 1 - (m_column_min[x] - lower) * scale;
+            double y_max = height - 1 - (m_column_max[x] - lower) * scale;
+            if (x == 0)
+              in_context->move_to(x + 0.5, y_min);
+            else
+              in_context->line_to(x + 0.5, y_min);
+            in_context->line_to(x + 0.5, y_max);
+          }
+        }
+        in_context->stroke();
+      }
+      return true;
+    }
+
+  private:
+    Gtk::DrawingArea *m_area;
+    std::vector<base::SampleRing *> m_channels;
+    size_t  m_history_size;
+    int     m_height;
+    std::atomic<double> m_lower, m_upper;
+    std::atomic<bool>   m_range_changed;
+    guint   m_tick_id;
+    uint64_t  m_drawn_head;
+    // work buffers (used from the GTK thread only)
+    std::vector<float> m_samples;
+    std::vector<float> m_column_min, m_column_max;
+
+    friend class WindowData;
+    friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  ReadoutData class (GtkLabel)
+  // ===========================================================================
+  // Shows the value of a std::atomic<double> owned by the user. The value is
+  // read and formatted on the GTK thread once per frame while the readout is
+  // mapped, and the label is only touched when the text changed. The producer
+  // just stores to its atomic (no formatting, no allocation, no event).
+  //
+  class ReadoutData : public WidgetData
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // get_value
+    // -------------------------------------------------------------------------
+    double get_value() const
+    {
+      if (m_source == nullptr)
+        return 0.0;
+      return m_source->load(std::memory_order_relaxed);
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // ReadoutData constructor
+    // -------------------------------------------------------------------------
+    ReadoutData(base::WindowBase *in_window,
+                const char *in_label_str,
+                const std::atomic<double> *in_source,
+                int in_precision,
+                std::chars_format in_format,
+                base::EventQueue *in_user_event_queue = nullptr) :
+        WidgetData(in_window, in_label_str, in_user_event_queue),
+        m_source(in_source),
+        m_precision(in_precision),
+        m_format(in_format),
+        m_readout(nullptr),
+        m_tick_id(0),
+        m_rendered_bits(0), m_rendered(false)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // ReadoutData destructor
+    // -------------------------------------------------------------------------
+    ~ReadoutData() override
+    {
+      delete m_readout;
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      Gtk::Box  *box = WidgetData::create();
+      if (box == nullptr)
+        return nullptr;
+      m_readout = new Gtk::Label();
+      if (m_readout == nullptr)
+        return nullptr;
+      m_readout->signal_map().connect(sigc::mem_fun(*this, &ReadoutData::on_map));
+      m_readout->signal_unmap().connect(sigc::mem_fun(*this, &ReadoutData::on_unmap));
+      refresh();
+      box->pack_end(*m_readout, Gtk::PACK_SHRINK);
+      return box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    void release() override
+    {
+      on_unmap();
+      delete m_readout;
+      m_readout = nullptr;
+      m_rendered = false;
+      m_text.clear();
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // store_snapshot
+    // -------------------------------------------------------------------------
+    void store_snapshot(SnapshotValue *out_value) const override
+    {
+      out_value->m_double = get_value();
+    }
+    // -------------------------------------------------------------------------
+    // on_map
+    // -------------------------------------------------------------------------
+    // [Note] nothing is read or formatted while the readout is not visible
+    //
+    void on_map()
+    {
+      if (m_tick_id == 0)
+        m_tick_id = m_readout->add_tick_callback(sigc::mem_fun(*this, &ReadoutData::on_tick));
+      refresh();
+    }
+    // -------------------------------------------------------------------------
+    // on_unmap
+    // -------------------------------------------------------------------------
+    void on_unmap()
+    {
+      if (m_tick_id != 0)
+        m_readout->remove_tick_callback(m_tick_id);
+      m_tick_id = 0;
+    }
+    // -------------------------------------------------------------------------
+    // on_tick
+    // -------------------------------------------------------------------------
+    bool on_tick(const Glib::RefPtr<Gdk::FrameClock> &in_frame_clock)
+    {
+      refresh();
+      return true;
+    }
+    // -------------------------------------------------------------------------
+    // refresh
+    // -------------------------------------------------------------------------
+    void refresh()
+    {
+      if (m_source == nullptr)
+        return;
+      double value = m_source->load(std::memory_order_relaxed);
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      if (m_rendered && bits == m_rendered_bits)
+        return;   // (compared bitwise, so NaN does not re-render either)
+      m_rendered_bits = bits;
+      m_rendered = true;
+      char buf[64];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      auto result = std::to_chars(buf, buf + sizeof(buf), value, m_format, m_precision);
+      size_t length = (result.ec == std::errc()) ? (size_t)(result.ptr - buf) : 0;
+#else
+      const char *format = (m_format == std::chars_format::scientific) ? "%.*e" :
+                           (m_format == std::chars_format::general) ? "%.*g" : "%.*f";
+      int length = snprintf(buf, sizeof(buf), format, m_precision, value);
+      length = std::max(0, std::min(length, (int)sizeof(buf) - 1));
+#endif
+      if (m_text.compare(0, std::string::npos, buf, length) == 0)
+        return;   // same text (e.g. the change is below the precision)
+      m_text.assign(buf, length);
+      m_readout->set_text(m_text);
+    }
+
+  private:
+    const std::atomic<double> *m_source;
+    int m_precision;
+    std::chars_format m_format;
+    Gtk::Label *m_readout;
+    guint m_tick_id;
+    // (GTK thread only) the last rendered value and text
+    uint64_t m_rendered_bits;
+    bool m_rendered;
+    std::string m_text;
+
+    friend class WindowData;
+    friend class WindowView;
+  };
+
+  // ===========================================================================
+  //  GroupData class (GtkExpander)
+  // ===========================================================================
+  // A collapsible group of widgets (see WindowData::add_group()). The
+  // children are created when the group is opened and released when it is
+  // closed, so a closed group costs no GTK work: the updates of its children
+  // only change the values kept in the WidgetData.
+  //
+  class GroupData : public WidgetData
+  {
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // get_child_num
+    // -------------------------------------------------------------------------
+    size_t get_child_num() const
+    {
+      return m_children.size();
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // GroupData constructor
+    // -------------------------------------------------------------------------
+    GroupData(base::WindowBase *in_window,
+              const char *in_label_str,
+              bool in_expanded,
+              base::EventQueue *in_user_event_queue = nullptr) :
+        WidgetData(in_window, in_label_str, in_user_event_queue),
+        m_expander(nullptr), m_child_box(nullptr),
+        m_expanded(in_expanded)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // GroupData destructor
+    // -------------------------------------------------------------------------
+    ~GroupData() override
+    {
+      delete m_child_box;
+      delete m_expander;
+    }
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      m_horiz_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_HORIZONTAL);
+      m_horiz_box->set_margin_left(8);
+      m_horiz_box->set_margin_right(8);
+      m_horiz_box->set_margin_top(2);
+      m_horiz_box->set_margin_bottom(2);
+      m_child_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_VERTICAL);
+      m_expander = new Gtk::Expander(m_label_str);
+      m_expander->add(*m_child_box);
+      m_expander->set_expanded(m_expanded);
+      if (m_expanded)
+        open_children();
+      m_expander->property_expanded().signal_changed().connect(
+              sigc::mem_fun(*this, &GroupData::on_expanded));
+      m_horiz_box->pack_start(*m_expander, Gtk::PACK_EXPAND_WIDGET);
+      return m_horiz_box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    void release() override
+    {
+      close_children();
+      delete m_child_box;
+      delete m_expander;
+      m_child_box = nullptr;
+      m_expander = nullptr;
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // is_container
+    // -------------------------------------------------------------------------
+    bool is_container() const override
+    {
+      return true;
+    }
+    // -------------------------------------------------------------------------
+    // on_expanded
+    // -------------------------------------------------------------------------
+    void on_expanded()
+    {
+      m_expanded = m_expander->get_expanded();
+      if (m_expanded)
+        open_children();
+      else
+        close_children();
+    }
+    // -------------------------------------------------------------------------
+    // open_children
+    // -------------------------------------------------------------------------
+    void open_children()
+    {
+      if (m_child_box == nullptr)  // (not created or already released)
+        return;
+      for (auto it = m_children.begin(); it != m_children.end(); it++)
       {
-        if (m_scale == nullptr)
-        {
-          m_initial.m_step_increment = in_step_increment;
-          m_initial.m_page_increment = in_page_increment;
-          return;
-        }
-        auto *update = new ScaleUpdate(this, process_update);
-        update->m_step_increment = in_step_increment;
-        update->m_page_increment = in_page_increment;
-        update->m_increments_updated = true;
-        push_update(update);
-        if (in_invoke_update)
-          invoke_update();
+        if ((*it)->is_created())
+          continue;
+        Gtk::Box *h_box = (*it)->create();
+        if (h_box == nullptr)
+          continue;
+        m_child_box->pack_start(*h_box, Gtk::PACK_SHRINK);
+        h_box->show_all();
+        (*it)->apply_filter();
       }
+    }
+    // -------------------------------------------------------------------------
+    // close_children
+    // -------------------------------------------------------------------------
+    void close_children()
+    {
+      for (auto it = m_children.begin(); it != m_children.end(); it++)
+        if ((*it)->is_created())
+          (*it)->release();
+    }
+
+    // member variables --------------------------------------------------------
+    Gtk::Expander *m_expander;
+    Gtk::Box *m_child_box;
+    bool m_expanded;  // (GTK thread after the window is shown)
+    std::vector<WidgetData *> m_children;
+
+    friend class WindowData;
+    friend class WindowView;
+    friend class NotebookData;
+  };
 
+  // ===========================================================================
+  //  PageData class (a page of GtkNotebook)
+  // ===========================================================================
+  // Only the children of the current page are created (see GroupData)
+  //
+  class PageData : public GroupData
+  {
   protected:
-      // -------------------------------------------------------------------------
-      // ScaleData constructor
-      // -------------------------------------------------------------------------
-      ScaleData( base::WindowBase *in_window,
-                 const char *in_label_str,
-                 double *in_user_variable,
-                 double in_lower, double in_upper,
-                 double in_step_increment = 1,
-                 double in_page_increment = 10,
-                 double in_page_size = 0,
-                 int in_digits = 0,
-                 void *in_user_data = nullptr,
-                 void (*in_value_changed_func)(void *, double) = nullptr,
+    // -------------------------------------------------------------------------
+    // PageData constructor
+    // -------------------------------------------------------------------------
+    PageData(base::WindowBase *in_window,
+             const char *in_label_str,
+             base::EventQueue *in_user_event_queue = nullptr) :
+        GroupData(in_window, in_label_str, false, in_user_event_queue)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // PageData destructor
+    // -------------------------------------------------------------------------
+    ~PageData() override = default;
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    // [Note] returns the page content (the children are added by open_children())
+    //
+    Gtk::Box *create() override
+    {
+      m_horiz_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_HORIZONTAL);
+      m_child_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_VERTICAL);
+      m_child_box->set_valign(Gtk::ALIGN_START);
+      m_horiz_box->pack_start(*m_child_box, Gtk::PACK_EXPAND_WIDGET);
+      return m_horiz_box;
+    }
+
+    friend class WindowData;
+    friend class NotebookData;
+  };
+
+  // ===========================================================================
+  //  NotebookData class (GtkNotebook)
+  // ===========================================================================
+  // Created by the first WindowData::add_page() call of a series of pages.
+  // Switching the page creates the children of the new page and releases the
+  // children of the others.
+  //
+  class NotebookData : public WidgetData
+  {
+  protected:
+    // -------------------------------------------------------------------------
+    // NotebookData constructor
+    // -------------------------------------------------------------------------
+    NotebookData(base::WindowBase *in_window,
                  base::EventQueue *in_user_event_queue = nullptr) :
-          WidgetData(in_window, in_label_str, in_user_event_queue),
-          m_user_variable(in_user_variable),
-          m_initial(0, in_lower, in_upper, in_step_increment,
-                    in_page_increment, in_page_size, in_digits),
-          m_user_data(in_user_data),
-          m_value_changed_func(in_value_changed_func),
-          m_scale(nullptr), m_value(0)
-      {
-        if (in_user_variable != nullptr)
-          m_initial.m_value = *in_user_variable;
-      }
-      // -------------------------------------------------------------------------
-      // ScaleData destructor
-      // -------------------------------------------------------------------------
-      ~ScaleData() override
-      {
-        delete m_scale;
-      }
+        WidgetData(in_window, "", in_user_event_queue),
+        m_notebook(nullptr),
+        m_current_page(0)
+    {
+    }
+    // -------------------------------------------------------------------------
+    // NotebookData destructor
+    // -------------------------------------------------------------------------
+    ~NotebookData() override
+    {
+      m_switch_connection.disconnect();
+      delete m_notebook;
+    }
 
-      // Member functions --------------------------------------------------------
-      // -------------------------------------------------------------------------
-      // create
-      // -------------------------------------------------------------------------
-      Gtk::Box *create() override
-      {
-        Gtk::Box  *box = WidgetData::create();
-        if (box == nullptr)
-          return nullptr;
-        if (m_user_variable != nullptr)
-          *m_user_variable = m_initial.m_value;
-        m_value = m_initial.m_value;
-        m_scale = new Gtk::Scale(
-            Gtk::Adjustment::create(
-                m_value,
-                m_initial.m_lower, m_initial.m_upper,
-                m_initial.m_step_increment,
-                m_initial.m_page_increment, m_initial.m_page_size));
-        if (m_scale == nullptr)
-          return nullptr;
-        m_scale->set_digits(m_initial.m_digits);
-        m_scale->signal_value_changed().connect(
-            sigc::mem_fun(*this, &ScaleData::queue_value_changed));
-        box->pack_end(*m_scale, Gtk::PACK_EXPAND_WIDGET);
-        return box;
-      }
-      // -------------------------------------------------------------------------
-      // queue_value_changed
-      // -------------------------------------------------------------------------
-      void queue_value_changed()
-      {
-        std::lock_guard<std::mutex> lock(m_value_mutex);
-        m_value = m_scale->get_value();
-        mark_as_updated();
-        if (m_value_changed_func == nullptr && m_user_variable == nullptr)
-          return;
-        auto *event = new ScaleEvent(
-            m_value,
-            this, process_value_changed);
-        push_event(event);
-      }
-      // -------------------------------------------------------------------------
-      // process_value_changed
-      // -------------------------------------------------------------------------
-      static void process_value_changed(base::EventData *in_event)
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // create
+    // -------------------------------------------------------------------------
+    Gtk::Box *create() override
+    {
+      m_horiz_box = new Gtk::Box(Gtk::Orientation::ORIENTATION_HORIZONTAL);
+      m_horiz_box->set_margin_left(8);
+      m_horiz_box->set_margin_right(8);
+      m_horiz_box->set_margin_top(2);
+      m_horiz_box->set_margin_bottom(2);
+      m_notebook = new Gtk::Notebook();
+      for (auto it = m_pages.begin(); it != m_pages.end(); it++)
+        m_notebook->append_page(*(*it)->create(), (*it)->m_label_str);
+      if (m_current_page < m_pages.size())
       {
-        auto *event = (ScaleEvent *)in_event;
-        auto  *spin = (ScaleData *)event->get_source();
-
-        if (spin->m_user_variable != nullptr)
-          *(spin->m_user_variable) = event->m_value;
-        if (spin->m_value_changed_func != nullptr)
-          spin->m_value_changed_func(spin->m_user_data, event->m_value);
-      }
-      // -------------------------------------------------------------------------
-      // process_update
-      // -------------------------------------------------------------------------
-      static void process_update(base::EventData *in_update)
+        m_notebook->set_current_page((int)m_current_page);
+        m_pages[m_current_page]->open_children();
+      }
+      m_switch_connection = m_notebook->signal_switch_page().connect(
+              sigc::mem_fun(*this, &NotebookData::on_switch_page));
+      m_horiz_box->pack_start(*m_notebook, Gtk::PACK_EXPAND_WIDGET);
+      return m_horiz_box;
+    }
+    // -------------------------------------------------------------------------
+    // release
+    // -------------------------------------------------------------------------
+    // [Note] removing the pages switches the current page of GtkNotebook, so
+    // the handler is disconnected first (it would reopen released pages)
+    //
+    void release() override
+    {
+      m_switch_connection.disconnect();
+      for (auto it = m_pages.begin(); it != m_pages.end(); it++)
+        if ((*it)->is_created())
+          (*it)->release();
+      delete m_notebook;
+      m_notebook = nullptr;
+      WidgetData::release();
+    }
+    // -------------------------------------------------------------------------
+    // is_container
+    // -------------------------------------------------------------------------
+    bool is_container() const override
+    {
+      return true;
+    }
+    // -------------------------------------------------------------------------
+    // on_switch_page
+    // -------------------------------------------------------------------------
+    void on_switch_page(Gtk::Widget *in_page, guint in_page_num)
+    {
+      m_current_page = in_page_num;
+      for (size_t i = 0; i < m_pages.size(); i++)
       {
-        auto *update = (ScaleUpdate *)in_update;
-        auto  *spin = (ScaleData *)update->get_source();
-
-        if (update->m_value_updated)
-        {
-          spin->m_scale->set_value(update->m_value);
-          return;
-        }
-        if (update->m_adjustment_called)
-        {
-          spin->m_scale->set_adjustment(Gtk::Adjustment::create(
-              update->m_value,
-              update->m_lower, update->m_upper,
-              update->m_step_increment,
-              update->m_page_increment, update->m_page_size));
-          return;
-        }
-        if (update->m_digits_updated)
-        {
-          spin->m_scale->set_digits(update->m_digits);
-          return;
-        }
-        if (update->m_range_updated)
-        {
-          spin->m_scale->set_range(update->m_lower,
-                                   update->m_upper);
-          return;
-        }
-        if (update->m_increments_updated)
-        {
-          spin->m_scale->set_increments(update->m_step_increment,
-                                        update->m_page_increment);
-          return;
-        }
+        if (i == in_page_num)
+          m_pages[i]->open_children();
+        else
+          m_pages[i]->close_children();
       }
+    }
 
   private:
-      Gtk::Scale *m_scale;
-      ScaleUpdate  m_initial;
-
-      double m_value;
-      std::mutex  m_value_mutex;
+    Gtk::Notebook *m_notebook;
+    std::vector<PageData *> m_pages;
+    size_t m_current_page;  // (GTK thread after the window is shown)
+    sigc::connection  m_switch_connection;
 
-      double *m_user_variable;
-      void *m_user_data;
-      void (*m_value_changed_func)(void *, double);
-
-      friend class WindowData;
-      friend class WindowView;
+    friend class WindowData;
   };
 
   // ===========================================================================
@@ -2959,7 +7107,10 @@ namespace controls     // shl::gtk::controls
     // -------------------------------------------------------------------------
     ~WindowData() override
     {
+      m_publish_idle.disconnect();
       delete_all_widgets();
+      for (auto it = m_params_list.begin(); it != m_params_list.end(); it++)
+        delete (*it);
     }
     // Member functions --------------------------------------------------------
     // -------------------------------------------------------------------------
@@ -3024,6 +7175,60 @@ namespace controls     // shl::gtk::controls
       return entry;
     }
     // -------------------------------------------------------------------------
+    // add_entry (callable version)
+    // -------------------------------------------------------------------------
+    // [Note] in_changed_func can be any callable of void(std::string_view)
+    // (e.g. a lambda with captures). It is stored without a heap allocation.
+    // The callables take the place of in_user_data and the function pointers
+    // of the overload above (the captures replace the user data)
+    //
+    template <typename F,
+              typename std::enable_if<
+                std::is_invocable<F &, std::string_view>::value, int>::type = 0>
+    EntryData *add_entry(const char *in_label_str,
+                  std::string *in_entry_text,
+                  int in_max_length,
+                  F &&in_changed_func,
+                  base::EventQueue *in_user_event_queue = nullptr)
+    {
+      EntryData  *entry;
+      entry = new EntryData(this,
+                            in_label_str,
+                            in_entry_text,
+                            in_max_length,
+                            nullptr, nullptr, nullptr,
+                            in_user_event_queue);
+      entry->m_changed_callback.assign(std::forward<F>(in_changed_func));
+      add_widget(entry);
+      return entry;
+    }
+    // -------------------------------------------------------------------------
+    // add_entry (callable version)
+    // -------------------------------------------------------------------------
+    template <typename F, typename G,
+              typename std::enable_if<
+                std::is_invocable<F &, std::string_view>::value &&
+                std::is_invocable<G &, std::string_view>::value, int>::type = 0>
+    EntryData *add_entry(const char *in_label_str,
+                  std::string *in_entry_text,
+                  int in_max_length,
+                  F &&in_changed_func,
+                  G &&in_done_func,
+                  base::EventQueue *in_user_event_queue = nullptr)
+    {
+      EntryData  *entry;
+      entry = new EntryData(this,
+                            in_label_str,
+                            in_entry_text,
+                            in_max_length,
+                            nullptr, nullptr, nullptr,
+                            in_user_event_queue);
+      entry->m_changed_callback.assign(std::forward<F>(in_changed_func));
+      entry->m_done_callback.assign(std::forward<G>(in_done_func));
+      add_widget(entry);
+      return entry;
+    }
+    // -------------------------------------------------------------------------
     // add_spin_button
     // -------------------------------------------------------------------------
     SpinButtonData *add_spin_button(const char *in_label_str,
@@ -3057,73 +7262,391 @@ namespace controls     // shl::gtk::controls
       return spin;
     }
     // -------------------------------------------------------------------------
-    // add_switch
+    // add_spin_button (callable version)
+    // -------------------------------------------------------------------------
+    // [Note] in_value_changed_func can be any callable of void(double)
+    // (e.g. a lambda with captures). It is stored without a heap allocation.
+    // It takes the place of in_user_data and in_value_changed_func of the
+    // overload above (the captures replace the user data)
+    //
+    template <typename F,
+              typename std::enable_if<
+                std::is_invocable<F &, double>::value, int>::type = 0>
+    SpinButtonData *add_spin_button(const char *in_label_str,
+                                    double *in_user_variable,
+                                    double in_lower, double in_upper,
+                                    double in_step_increment,
+                                    double in_page_increment,
+                                    double in_page_size,
+                                    double in_climb_rate,
+                                    guint in_digits,
+                                    F &&in_value_changed_func,
+                                    bool in_wrap = false, bool in_numeric = false,
+                                    base::EventQueue *in_user_event_queue = nullptr)
+    {
+      SpinButtonData  *spin;
+      spin = new SpinButtonData(this,
+                                in_label_str,
+                                in_user_variable,
+                                in_lower, in_upper,
+                                in_step_increment,
+                                in_page_increment,
+                                in_page_size,
+                                in_climb_rate,
+                                in_digits,
+                                nullptr, nullptr,
+                                in_wrap, in_numeric,
+                                in_user_event_queue);
+      spin->m_changed_callback.assign(std::forward<F>(in_value_changed_func));
+      add_widget(spin);
+      return spin;
+    }
+    // -------------------------------------------------------------------------
+    // add_switch
+    // -------------------------------------------------------------------------
+    SwitchData *add_switch(const char *in_label_str,
+                           bool *in_user_variable,
+                           void *in_user_data = nullptr,
+                           void (*in_toggled_func)(void *in_user_data) = nullptr,
+                           base::EventQueue *in_user_event_queue = nullptr)
+    {
+      SwitchData  *button;
+      button = new SwitchData(this,
+                              in_label_str,
+                              in_user_variable,
+                              in_user_data,
+                              in_toggled_func,
+                              in_user_event_queue);
+      add_widget(button);
+      return button;
+    }
+    // -------------------------------------------------------------------------
+    // add_combo_box
+    // -------------------------------------------------------------------------
+    ComboBoxData *add_combo_box(const char *in_label_str,
+                           const std::vector<std::string> &in_items,
+                           int *in_user_variable,
+                           void *in_user_data = nullptr,
+                           void (*in_changed_func)(void *in_user_data) = nullptr,
+                           base::EventQueue *in_user_event_queue = nullptr)
+    {
+      ComboBoxData  *comboBox;
+      comboBox = new ComboBoxData(this,
+                              in_label_str,
+                              in_items,
+                              in_user_variable,
+                              in_user_data,
+                              in_changed_func,
+                              in_user_event_queue);
+      add_widget(comboBox);
+      return comboBox;
+    }
+    // -------------------------------------------------------------------------
+    // add_scale
+    // -------------------------------------------------------------------------
+    ScaleData *add_scale(const char *in_label_str,
+                               double *in_user_variable,
+                               double in_lower, double in_upper,
+                               double in_step_increment = 1,
+                               double in_page_increment = 10,
+                               double in_page_size = 0,
+                               int    in_digits = 0,
+                               void *in_user_data = nullptr,
+                               void (*in_value_changed_func)(void *, double) = nullptr,
+                               base::EventQueue *in_user_event_queue = nullptr)
+    {
+      ScaleData  *spin;
+      spin = new ScaleData(this,
+                           in_label_str,
+                           in_user_variable,
+                           in_lower, in_upper,
+                           in_step_increment,
+                           in_page_increment,
+                           in_page_size,
+                           in_digits,
+                           in_user_data,
+                           in_value_changed_func,
+                           in_user_event_queue);
+      add_widget(spin);
+      return spin;
+    }
+    // -------------------------------------------------------------------------
+    // add_scale (callable version)
+    // -------------------------------------------------------------------------
+    // [Note] same parameter order as add_spin_button (callable version)
+    //
+    template <typename F,
+              typename std::enable_if<
+                std::is_invocable<F &, double>::value, int>::type = 0>
+    ScaleData *add_scale(const char *in_label_str,
+                               double *in_user_variable,
+                               double in_lower, double in_upper,
+                               double in_step_increment,
+                               double in_page_increment,
+                               double in_page_size,
+                               int    in_digits,
+                               F &&in_value_changed_func,
+                               base::EventQueue *in_user_event_queue = nullptr)
+    {
+      ScaleData  *scale;
+      scale = new ScaleData(this,
+                            in_label_str,
+                            in_user_variable,
+                            in_lower, in_upper,
+                            in_step_increment,
+                            in_page_increment,
+                            in_page_size,
+                            in_digits,
+                            nullptr, nullptr,
+                            in_user_event_queue);
+      scale->m_changed_callback.assign(std::forward<F>(in_value_changed_func));
+      add_widget(scale);
+      return scale;
+    }
+
+    // -------------------------------------------------------------------------
+    // add_group
+    // -------------------------------------------------------------------------
+    /**
+     * Adds a collapsible group. The widgets added after this call (until
+     * the next add_group(), add_page() or end_group()) go into the group and
+     * are only created while the group is open.
+     *
+     * @param in_label_str  The label of the group
+     * @param in_expanded   true to open the group when the window is shown
+     */
+    GroupData *add_group(const char *in_label_str, bool in_expanded = false,
+                         base::EventQueue *in_user_event_queue = nullptr)
+    {
+      end_group();
+      GroupData  *group;
+      group = new GroupData(this,
+                            in_label_str,
+                            in_expanded,
+                            in_user_event_queue);
+      add_widget(group);
+      m_current_group = group;
+      return group;
+    }
+    // -------------------------------------------------------------------------
+    // add_page
+    // -------------------------------------------------------------------------
+    /**
+     * Adds a notebook page (consecutive add_page() calls share one notebook).
+     * The widgets added after this call go into the page and are only
+     * created while the page is the current one.
+     *
+     * @param in_label_str  The label of the tab
+     */
+    PageData *add_page(const char *in_label_str,
+                       base::EventQueue *in_user_event_queue = nullptr)
+    {
+      NotebookData *notebook = m_current_notebook;
+      end_group();
+      if (notebook == nullptr)
+      {
+        notebook = new NotebookData(this, in_user_event_queue);
+        add_widget(notebook);
+      }
+      PageData  *page;
+      page = new PageData(this,
+                          in_label_str,
+                          in_user_event_queue);
+      add_widget(page);
+      page->m_parent = notebook;
+      notebook->m_pages.push_back(page);
+      m_current_notebook = notebook;
+      m_current_group = page;
+      return page;
+    }
+    // -------------------------------------------------------------------------
+    // end_group
+    // -------------------------------------------------------------------------
+    // [Note] the widgets added after this call go to the top level
+    //
+    void end_group()
+    {
+      m_current_group = nullptr;
+      m_current_notebook = nullptr;
+    }
+    // -------------------------------------------------------------------------
+    // find
+    // -------------------------------------------------------------------------
+    // Returns the widget registered with in_name (the label, or the key set
+    // by set_key()) or nullptr. W selects the widget type:
+    //   window.find<SpinButtonData>("Exposure")->set_value(10.0);
+    // [Note] the index is written by add_*() and set_key(): call them before
+    // the window is shown (or from the thread that calls find())
+    //
+    template <class W = WidgetData>
+    W *find(std::string_view in_name) const
+    {
+      auto it = m_name_index.find(std::string(in_name));
+      if (it == m_name_index.end())
+        return nullptr;
+      if constexpr (std::is_same<W, WidgetData>::value)
+        return it->second;
+      else
+        return dynamic_cast<W *>(it->second);
+    }
+    // -------------------------------------------------------------------------
+    // set_key
+    // -------------------------------------------------------------------------
+    /**
+     * Registers in_widget with an explicit key for find(). Labels are
+     * registered by add_*() (the first widget wins if labels are not unique).
+     *
+     * @param in_key     The key (replaces the widget registered with it)
+     * @param in_widget  The widget
+     */
+    void set_key(const char *in_key, WidgetData *in_widget)
+    {
+      m_name_index[in_key] = in_widget;
+    }
+    // -------------------------------------------------------------------------
+    // set_values
+    // -------------------------------------------------------------------------
+    // Sets the values of the widgets found by name as one batch: the updates
+    // are queued first and the GTK thread is woken once for all of them.
+    //   window.set_values({{"Gain", 2.0}, {"Enabled", 1}});
+    // Returns the number of the widgets that were set
+    //
+    size_t set_values(std::initializer_list<std::pair<std::string_view, double>> in_values)
+    {
+      size_t num = 0;
+      for (auto it = in_values.begin(); it != in_values.end(); it++)
+      {
+        WidgetData *widget = find(it->first);
+        if (widget != nullptr && widget->set_number(it->second, false))
+          num++;
+      }
+      if (num != 0)
+        update();
+      return num;
+    }
+    // -------------------------------------------------------------------------
+    // set_virtualized_view
+    // -------------------------------------------------------------------------
+    /**
+     * Only the rows in (and near) the visible area get GTK widgets; the rows
+     * scrolled out are deleted again. Use it for panels with thousands of
+     * controls. Must be called before the window is shown.
+     * [Note] groups and pages are not shown in the virtualized view (their
+     * widgets become plain rows)
+     *
+     * @param in_enable      true to enable the virtualized view
+     * @param in_row_height  The height of a row in pixels (a taller widget,
+     *                       e.g. a plot, gets a row of its own height)
+     */
+    void set_virtualized_view(bool in_enable, int in_row_height = 36)
+    {
+      m_virtualized_view = in_enable;
+      m_row_height = std::max(in_row_height, 1);
+    }
+    // -------------------------------------------------------------------------
+    // acquire_snapshot
+    // -------------------------------------------------------------------------
+    // Returns the latest consistent copy of all widget values (one atomic
+    // exchange, no lock). The snapshots are triple buffered: the GTK thread
+    // fills a back buffer and swaps it with the published one, and this
+    // function swaps the published one with the buffer the caller held.
+    // A snapshot is published once per update (or main loop iteration for
+    // the changes made on the window), not per changed widget.
+    // [Note] single consumer: the returned snapshot stays valid (and
+    // unchanged) until the next acquire_snapshot() call
+    //
+    const Snapshot *acquire_snapshot()
+    {
+      return m_snapshots.acquire();
+    }
+    // -------------------------------------------------------------------------
+    // take_changed
     // -------------------------------------------------------------------------
-    SwitchData *add_switch(const char *in_label_str,
-                           bool *in_user_variable,
-                           void *in_user_data = nullptr,
-                           void (*in_toggled_func)(void *in_user_data) = nullptr,
-                           base::EventQueue *in_user_event_queue = nullptr)
+    // Stores the widgets changed since the previous take_changed() call (in
+    // the order they were added) to out_widgets and returns the number.
+    // The cost is proportional to the number of changed widgets.
+    //
+    size_t take_changed(std::vector<WidgetData *> *out_widgets)
     {
-      SwitchData  *button;
-      button = new SwitchData(this,
-                              in_label_str,
-                              in_user_variable,
-                              in_user_data,
-                              in_toggled_func,
-                              in_user_event_queue);
-      add_widget(button);
-      return button;
+      out_widgets->clear();
+      return m_changed_bitmap.take([&](size_t in_index) {
+        out_widgets->push_back(m_widget_list[in_index]);
+      });
     }
     // -------------------------------------------------------------------------
-    // add_combo_box
+    // bind_params
     // -------------------------------------------------------------------------
-    ComboBoxData *add_combo_box(const char *in_label_str,
-                           const std::vector<std::string> &in_items,
-                           int *in_user_variable,
-                           void *in_user_data = nullptr,
-                           void (*in_changed_func)(void *in_user_data) = nullptr,
-                           base::EventQueue *in_user_event_queue = nullptr)
+    // Creates a binding between a parameter struct and the widgets created by
+    // ParamsBinding::bind<&P::field>(). Changes are written straight into
+    // the struct on the GTK thread (no user event is queued).
+    //
+    template <class P>
+    ParamsBinding<P> *bind_params(const P &in_initial = P())
     {
-      ComboBoxData  *comboBox;
-      comboBox = new ComboBoxData(this,
-                              in_label_str,
-                              in_items,
-                              in_user_variable,
-                              in_user_data,
-                              in_changed_func,
-                              in_user_event_queue);
-      add_widget(comboBox);
-      return comboBox;
+      auto *binding = new ParamsBinding<P>(this, in_initial);
+      m_params_list.push_back(binding);
+      return binding;
     }
+
     // -------------------------------------------------------------------------
-    // add_scale
+    // add_plot
     // -------------------------------------------------------------------------
-    ScaleData *add_scale(const char *in_label_str,
-                               double *in_user_variable,
-                               double in_lower, double in_upper,
-                               double in_step_increment = 1,
-                               double in_page_increment = 10,
-                               double in_page_size = 0,
-                               int    in_digits = 0,
-                               void *in_user_data = nullptr,
-                               void (*in_value_changed_func)(void *, double) = nullptr,
-                               base::EventQueue *in_user_event_queue = nullptr)
-    {
-      ScaleData  *spin;
-      spin = new ScaleData(this,
-                           in_label_str,
-                           in_user_variable,
-                           in_lower, in_upper,
-                           in_step_increment,
-                           in_page_increment,
-                           in_page_size,
-                           in_digits,
-                           in_user_data,
-                           in_value_changed_func,
-                           in_user_event_queue);
-      add_widget(spin);
-      return spin;
+    /**
+     * Adds a strip chart. Feed it with PlotData::push_sample() (or
+     * push_samples()) from any thread (one producer thread per channel).
+     *
+     * @param in_label_str     The label
+     * @param in_channel_num   The number of channels (lines)
+     * @param in_history_size  The number of samples shown per channel
+     * @param in_lower         The value at the bottom edge
+     * @param in_upper         The value at the top edge
+     * @param in_height        The height of the plot in pixels
+     */
+    PlotData *add_plot(const char *in_label_str,
+                       size_t in_channel_num = 1,
+                       size_t in_history_size = 4096,
+                       double in_lower = -1.0, double in_upper = 1.0,
+                       int in_height = 120,
+                       base::EventQueue *in_user_event_queue = nullptr)
+    {
+      PlotData  *plot;
+      plot = new PlotData(this,
+                          in_label_str,
+                          in_channel_num,
+                          in_history_size,
+                          in_lower, in_upper,
+                          in_height,
+                          in_user_event_queue);
+      add_widget(plot);
+      return plot;
+    }
+    // -------------------------------------------------------------------------
+    // add_readout
+    // -------------------------------------------------------------------------
+    /**
+     * Adds a numeric readout of *in_source. The producer only stores to the
+     * atomic; the text is formatted on the GTK thread when it is shown.
+     *
+     * @param in_label_str  The label
+     * @param in_source     The value to show (must outlive the window)
+     * @param in_precision  The precision passed to std::to_chars
+     * @param in_format     The format passed to std::to_chars
+     */
+    ReadoutData *add_readout(const char *in_label_str,
+                             const std::atomic<double> *in_source,
+                             int in_precision = 3,
+                             std::chars_format in_format = std::chars_format::fixed,
+                             base::EventQueue *in_user_event_queue = nullptr)
+    {
+      ReadoutData  *readout;
+      readout = new ReadoutData(this,
+                                in_label_str,
+                                in_source,
+                                in_precision,
+                                in_format,
+                                in_user_event_queue);
+      add_widget(readout);
+      return readout;
     }
 
   protected:
@@ -3131,7 +7654,14 @@ namespace controls     // shl::gtk::controls
     // WindowData constructor
     // -------------------------------------------------------------------------
     WindowData(base::EventQueue *in_user_event_queue = nullptr) :
-      base::WindowBase(in_user_event_queue)
+      base::WindowBase(in_user_event_queue),
+      m_snapshot_generation(0),
+      m_publish_pending(false),
+      m_updating(false),
+      m_virtualized_view(false),
+      m_row_height(36),
+      m_current_group(nullptr),
+      m_current_notebook(nullptr)
     {
     }
     // Member functions --------------------------------------------------------
@@ -3141,7 +7671,68 @@ namespace controls     // shl::gtk::controls
     void add_widget(WidgetData *in_widget_data)
     {
       if (in_widget_data != nullptr)
+      {
+        in_widget_data->m_index = m_widget_list.size();
         m_widget_list.push_back(in_widget_data);
+        m_changed_bitmap.resize(m_widget_list.size());
+        if (m_current_group != nullptr)
+        {
+          in_widget_data->m_parent = m_current_group;
+          m_current_group->m_children.push_back(in_widget_data);
+        }
+        if (in_widget_data->m_label_str.empty() == false)
+          m_name_index.emplace(in_widget_data->m_label_str, in_widget_data);
+      }
+    }
+    // -------------------------------------------------------------------------
+    // notify_widget_changed
+    // -------------------------------------------------------------------------
+    // [Note] only marks the snapshot as dirty: it is published at the end of
+    // update_widgets(), or from an idle callback for the changes made on the
+    // window (one publish for any number of changed widgets)
+    //
+    void notify_widget_changed(size_t in_widget_index) override
+    {
+      m_changed_bitmap.set(in_widget_index);
+      if (m_publish_pending)
+        return;
+      m_publish_pending = true;
+      if (m_updating == false)
+        m_publish_idle = Glib::signal_idle().connect(
+                sigc::mem_fun(*this, &WindowData::on_publish_idle));
+    }
+    // -------------------------------------------------------------------------
+    // on_publish_idle (called from the UI thread)
+    // -------------------------------------------------------------------------
+    bool on_publish_idle()
+    {
+      publish_changes();
+      return false;
+    }
+    // -------------------------------------------------------------------------
+    // publish_changes (NOTE: need to be called from a GUI thread)
+    // -------------------------------------------------------------------------
+    void publish_changes()
+    {
+      if (m_publish_pending == false)
+        return;
+      m_publish_pending = false;
+      m_publish_idle.disconnect();
+      for (auto it = m_params_list.begin(); it != m_params_list.end(); it++)
+        (*it)->publish();
+      publish_snapshot();
+    }
+    // -------------------------------------------------------------------------
+    // publish_snapshot (NOTE: need to be called from a GUI thread)
+    // -------------------------------------------------------------------------
+    void publish_snapshot()
+    {
+      Snapshot *snapshot = m_snapshots.get_back();
+      snapshot->m_values.resize(m_widget_list.size());
+      for (size_t i = 0; i < m_widget_list.size(); i++)
+        m_widget_list[i]->store_snapshot(&snapshot->m_values[i]);
+      snapshot->m_generation = ++m_snapshot_generation;
+      m_snapshots.publish();
     }
     // -------------------------------------------------------------------------
     // delete_all_widgets
@@ -3164,17 +7755,219 @@ namespace controls     // shl::gtk::controls
     void update_widgets()
     {
       // Need to specify in_last_only = false explicitly
+      m_updating = true;
       process_update_events(false);
+      m_updating = false;
+      publish_changes();
     }
 
   private:
     // member variables --------------------------------------------------------
     std::vector<WidgetData *>   m_widget_list;
+    std::vector<ParamsBindingBase *> m_params_list;
+    base::DirtyBitmap m_changed_bitmap;
+    base::TripleBuffer<Snapshot> m_snapshots;
+    uint64_t  m_snapshot_generation;
+    bool  m_publish_pending;  // (GTK thread) see notify_widget_changed()
+    bool  m_updating;
+    sigc::connection  m_publish_idle;
+    bool  m_virtualized_view;
+    int   m_row_height;
+    std::unordered_map<std::string, WidgetData *> m_name_index;
+    GroupData     *m_current_group;     // (while adding widgets)
+    NotebookData  *m_current_notebook;
 
     // friend classes ----------------------------------------------------------
     friend class WindowView;
   };
 
+  // ===========================================================================
+  //  ParamSpec struct
+  // ===========================================================================
+  struct ParamSpec
+  {
+    double m_lower = 0.0, m_upper = 100.0;
+    double m_step_increment = 1.0;
+    double m_page_increment = 10.0;
+    guint  m_digits = 0;
+  };
+
+  // ===========================================================================
+  //  ParamsBinding class
+  // ===========================================================================
+  // Generates the widgets of a parameter struct P, one per bind() call, and
+  // keeps a triple-buffered copy of P up to date. The field access is
+  // resolved at compile time (one template instance per member pointer).
+  //   auto *params = window->bind_params<Params>();
+  //   params->bind<&Params::gain>("Gain", {0.0, 10.0, 0.1, 1.0, 2});
+  //   params->bind<&Params::enabled>("Enabled");
+  //   ...
+  //   const Params *p = params->acquire();   // from the user thread
+  //
+  // field type  : widget
+  // bool        : SwitchData
+  // std::string : EntryData
+  // arithmetic  : SpinButtonData (or ScaleData with bind_scale())
+  //
+  template <class P>
+  class ParamsBinding : public ParamsBindingBase
+  {
+  private:
+    template <class M> struct MemberField;
+    template <class C, class F> struct MemberField<F C::*>
+    {
+      typedef C owner_type;
+      typedef F field_type;
+    };
+
+  public:
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // acquire
+    // -------------------------------------------------------------------------
+    // [Note] single consumer: the returned struct stays valid (and unchanged)
+    // until the next acquire() call
+    //
+    const P *acquire()
+    {
+      return m_params.acquire();
+    }
+    // -------------------------------------------------------------------------
+    // bind
+    // -------------------------------------------------------------------------
+    template <auto M>
+    auto *bind(const char *in_label_str, const ParamSpec &in_spec = ParamSpec())
+    {
+      typedef typename MemberField<decltype(M)>::field_type F;
+      static_assert(std::is_same<typename MemberField<decltype(M)>::owner_type, P>::value,
+                    "M must be a data member pointer of P");
+      if constexpr (std::is_same<F, bool>::value)
+      {
+        SwitchData *button = m_window->add_switch(in_label_str, nullptr);
+        button->set_value(m_master.*M);
+        attach(button, store_value<M>);
+        return button;
+      }
+      else if constexpr (std::is_same<F, std::string>::value)
+      {
+        EntryData *entry = m_window->add_entry(in_label_str, nullptr);
+        entry->set_value(m_master.*M);
+        attach(entry, store_value<M>);
+        return entry;
+      }
+      else
+      {
+        static_assert(std::is_arithmetic<F>::value, "unsupported field type");
+        SpinButtonData *spin = m_window->add_spin_button(
+                in_label_str, nullptr,
+                in_spec.m_lower, in_spec.m_upper,
+                in_spec.m_step_increment, in_spec.m_page_increment,
+                0, 0, in_spec.m_digits);
+        spin->set_value((double)(m_master.*M));
+        attach(spin, store_value<M>);
+        return spin;
+      }
+    }
+    // -------------------------------------------------------------------------
+    // bind_scale
+    // -------------------------------------------------------------------------
+    template <auto M>
+    ScaleData *bind_scale(const char *in_label_str, const ParamSpec &in_spec = ParamSpec())
+    {
+      typedef typename MemberField<decltype(M)>::field_type F;
+      static_assert(std::is_same<typename MemberField<decltype(M)>::owner_type, P>::value,
+                    "M must be a data member pointer of P");
+      static_assert(std::is_arithmetic<F>::value, "unsupported field type");
+      ScaleData *scale = m_window->add_scale(
+              in_label_str, nullptr,
+              in_spec.m_lower, in_spec.m_upper,
+              in_spec.m_step_increment, in_spec.m_page_increment,
+              0, (int)in_spec.m_digits);
+      scale->set_value((double)(m_master.*M));
+      attach(scale, store_value<M>);
+      return scale;
+    }
+
+  protected:
+    // -------------------------------------------------------------------------
+    // ParamsBinding constructor
+    // -------------------------------------------------------------------------
+    ParamsBinding(WindowData *in_window, const P &in_initial) :
+        m_window(in_window),
+        m_master(in_initial),
+        m_is_dirty(false)
+    {
+      m_params.fill(in_initial);
+    }
+    // -------------------------------------------------------------------------
+    // ParamsBinding destructor
+    // -------------------------------------------------------------------------
+    ~ParamsBinding() override = default;
+
+    // Member functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // attach
+    // -------------------------------------------------------------------------
+    void attach(WidgetData *in_widget, void (*in_store)(const WidgetData *, void *))
+    {
+      in_widget->m_params_binding = this;
+      in_widget->m_params_store = in_store;
+    }
+    // -------------------------------------------------------------------------
+    // store_field
+    // -------------------------------------------------------------------------
+    // [Note] only updates m_master: the copy is published by publish(), once
+    // per update of the window (see WindowData::publish_changes())
+    //
+    void store_field(const WidgetData *in_widget,
+                     void (*in_store)(const WidgetData *, void *)) override
+    {
+      in_store(in_widget, &m_master);
+      m_is_dirty = true;
+    }
+    // -------------------------------------------------------------------------
+    // publish
+    // -------------------------------------------------------------------------
+    void publish() override
+    {
+      if (m_is_dirty == false)
+        return;
+      m_is_dirty = false;
+      *m_params.get_back() = m_master;
+      m_params.publish();
+    }
+    // static functions --------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // store_value
+    // -------------------------------------------------------------------------
+    template <auto M>
+    static void store_value(const WidgetData *in_widget, void *io_params)
+    {
+      typedef typename MemberField<decltype(M)>::field_type F;
+      SnapshotValue value;
+      in_widget->store_snapshot(&value);
+      F &field = ((P *)io_params)->*M;
+      if constexpr (std::is_same<F, bool>::value)
+        field = value.m_bool;
+      else if constexpr (std::is_same<F, std::string>::value)
+        field.swap(value.m_text);
+      else if constexpr (std::is_integral<F>::value)
+        field = (F)std::llround(value.m_double);
+      else
+        field = (F)value.m_double;
+    }
+
+  private:
+    // member variables --------------------------------------------------------
+    WindowData *m_window;
+    P m_master;   // owned by the GTK thread
+    bool m_is_dirty;  // (GTK thread) m_master was changed since publish()
+    base::TripleBuffer<P> m_params;
+
+    // friend classes ----------------------------------------------------------
+    friend class WindowData;
+  };
+
   // ===========================================================================
   // WindowView class
   // ===========================================================================
@@ -3189,22 +7982,58 @@ namespace controls     // shl::gtk::controls
     WindowView(WindowData *in_controls_data) :
             Glib::ObjectBase("WindowView"),
             m_vert_box(Gtk::Orientation::ORIENTATION_VERTICAL),
-            m_controls_data(in_controls_data)
+            m_controls_data(in_controls_data),
+            m_row_height(in_controls_data->m_row_height),
+            m_row_width(0),
+            m_live_first(0), m_live_last(0)
     {
-      m_vert_box.set_valign(Gtk::ALIGN_START);
-      for (auto it = m_controls_data->get_list()->begin(); it != m_controls_data->get_list()->end(); it++)
+      std::vector<WidgetData *> *list = m_controls_data->get_list();
+      for (auto it = list->begin(); it != list->end(); it++)
       {
-        Gtk::Box *h_box = (*it)->create();
-        if (h_box != nullptr)
-          m_vert_box.pack_start(*h_box);
+        (*it)->initialize();
+        (*it)->m_is_filtered_out = false;  // (the filter of a previous view)
+        if (m_controls_data->m_virtualized_view)
+        {
+          if ((*it)->is_container() == false)
+            m_rows.push_back(*it);
+        }
+        else if ((*it)->m_parent == nullptr)
+          m_rows.push_back(*it);  // (the children are created by the groups)
+      }
+      if (m_controls_data->m_virtualized_view)
+      {
+        update_row_offsets();
+        m_layout.set_size(1, (guint)m_row_offsets.back());
+        m_layout.signal_size_allocate().connect(
+                sigc::mem_fun(*this, &WindowView::on_layout_allocate));
+        get_vadjustment()->signal_value_changed().connect(
+                sigc::mem_fun(*this, &WindowView::update_rows));
+        this->add(m_layout);
+      }
+      else
+      {
+        m_vert_box.set_valign(Gtk::ALIGN_START);
+        for (auto it = m_rows.begin(); it != m_rows.end(); it++)
+        {
+          Gtk::Box *h_box = (*it)->create();
+          if (h_box != nullptr)
+            m_vert_box.pack_start(*h_box);
+        }
+        this->add(m_vert_box);
       }
-      this->add(m_vert_box);
+      m_controls_data->publish_snapshot();
     }
     // -------------------------------------------------------------------------
     // WindowView destructor
     // -------------------------------------------------------------------------
     ~WindowView() override
     {
+      // [Note] the values are kept in the WidgetData for the next WindowView
+      // (a group is released before its children)
+      std::vector<WidgetData *> *list = m_controls_data->get_list();
+      for (auto it = list->begin(); it != list->end(); it++)
+        if ((*it)->is_created())
+          (*it)->release();
       SHL_DBG_OUT("WindowView was deleted");
     }
     // ---------------------------------------------------------------------------
@@ -3214,10 +8043,161 @@ namespace controls     // shl::gtk::controls
     {
       m_controls_data->update_widgets();
     }
+    // -------------------------------------------------------------------------
+    // set_filter
+    // -------------------------------------------------------------------------
+    // Shows only the widgets whose label contains in_query (all widgets if
+    // empty). A group is shown if one of its children matches, and all of
+    // its children are shown if the group label matches. The rows are only
+    // hidden (nothing is rebuilt); the virtualized view re-packs its rows.
+    //
+    void set_filter(std::string_view in_query)
+    {
+      std::vector<WidgetData *> *list = m_controls_data->get_list();
+      if (m_label_index.size() != list->size())
+      {
+        m_label_index.clear();
+        for (auto it = list->begin(); it != list->end(); it++)
+          m_label_index.add((*it)->m_label_str);
+      }
+      m_label_index.find(in_query, &m_label_match);
+      // (the children are always added after their group)
+      std::vector<char> &match = m_label_match;
+      m_parent_match.assign(match.begin(), match.end());
+      for (size_t i = 0; i < list->size(); i++)
+      {
+        WidgetData *parent = (*list)[i]->m_parent;
+        if (parent != nullptr && m_parent_match[parent->m_index])
+          match[i] = m_parent_match[i] = 1;
+      }
+      for (size_t i = list->size(); i-- > 0;)
+      {
+        WidgetData *parent = (*list)[i]->m_parent;
+        if (parent != nullptr && match[i])
+          match[parent->m_index] = 1;
+      }
+      if (m_controls_data->m_virtualized_view)
+      {
+        for (auto it = m_rows.begin(); it != m_rows.end(); it++)
+          if ((*it)->is_created())
+            (*it)->release();
+        m_rows.clear();
+        for (size_t i = 0; i < list->size(); i++)
+          if (match[i] && (*list)[i]->is_container() == false)
+            m_rows.push_back((*list)[i]);
+        m_live_first = m_live_last = 0;
+        update_row_offsets();
+        m_layout.set_size((guint)std::max(m_row_width, 1), (guint)m_row_offsets.back());
+        update_rows();
+        return;
+      }
+      for (size_t i = 0; i < list->size(); i++)
+      {
+        WidgetData *widget = (*list)[i];
+        bool filtered_out = (match[i] == 0);
+        if (widget->m_is_filtered_out == filtered_out)
+          continue;
+        widget->m_is_filtered_out = filtered_out;
+        if (widget->is_created())
+          widget->m_horiz_box->set_visible(filtered_out == false);
+      }
+    }
+    // -------------------------------------------------------------------------
+    // on_layout_allocate
+    // -------------------------------------------------------------------------
+    void on_layout_allocate(Gtk::Allocation &in_allocation)
+    {
+      int width = in_allocation.get_width();
+      if (width != m_row_width)
+      {
+        m_row_width = width;
+        m_layout.set_size((guint)std::max(width, 1), (guint)m_row_offsets.back());
+        for (size_t i = m_live_first; i < m_live_last; i++)
+          if (m_rows[i]->is_created())
+            m_rows[i]->m_horiz_box->set_size_request(
+                    m_row_width, m_row_offsets[i + 1] - m_row_offsets[i]);
+      }
+      update_rows();
+    }
+    // -------------------------------------------------------------------------
+    // update_row_offsets
+    // -------------------------------------------------------------------------
+    // [Note] m_row_offsets[i] is the y of m_rows[i] (prefix sums of the row
+    // heights, the last element is the height of the layout)
+    //
+    void update_row_offsets()
+    {
+      m_row_offsets.resize(m_rows.size() + 1);
+      m_row_offsets[0] = 0;
+      for (size_t i = 0; i < m_rows.size(); i++)
+        m_row_offsets[i + 1] = m_row_offsets[i] + m_rows[i]->get_row_height(m_row_height);
+    }
+    // -------------------------------------------------------------------------
+    // find_row
+    // -------------------------------------------------------------------------
+    // Returns the index of the row at in_y (m_rows.size() if below the last)
+    //
+    size_t find_row(double in_y) const
+    {
+      auto it = std::upper_bound(m_row_offsets.begin(), m_row_offsets.end(), (int)in_y);
+      if (it == m_row_offsets.begin())
+        return 0;
+      return (size_t)(it - m_row_offsets.begin()) - 1;
+    }
+    // -------------------------------------------------------------------------
+    // update_rows
+    // -------------------------------------------------------------------------
+    // Creates the rows in the visible range (+ ROW_MARGIN rows) and releases
+    // the rows that are more than 2 * ROW_MARGIN rows away from it. The cost
+    // depends on the visible rows only, not on the number of widgets.
+    //
+    void update_rows()
+    {
+      Glib::RefPtr<Gtk::Adjustment> adjustment = get_vadjustment();
+      double top = std::max(adjustment->get_value(), 0.0);
+      double bottom = top + adjustment->get_page_size();
+      size_t first = find_row(top);
+      size_t last = find_row(bottom) + 1 + ROW_MARGIN;
+      first = (first > ROW_MARGIN) ? first - ROW_MARGIN : 0;
+      last = std::min(last, m_rows.size());
+      if (first > last)
+        first = last;
+      // (hysteresis: a row is kept until it is ROW_MARGIN rows further away)
+      size_t keep_first = (first > ROW_MARGIN) ? first - ROW_MARGIN : 0;
+      size_t keep_last = std::min(last + ROW_MARGIN, m_rows.size());
+      for (size_t i = m_live_first; i < m_live_last; i++)
+        if ((i < keep_first || i >= keep_last) && m_rows[i]->is_created())
+          m_rows[i]->release();
+      for (size_t i = first; i < last; i++)
+      {
+        WidgetData *widget = m_rows[i];
+        if (widget->is_created())
+          continue;
+        Gtk::Box *h_box = widget->create();
+        if (h_box == nullptr)
+          continue;
+        h_box->set_size_request(m_row_width, m_row_offsets[i + 1] - m_row_offsets[i]);
+        m_layout.put(*h_box, 0, m_row_offsets[i]);
+        h_box->show_all();
+      }
+      // the created rows are within [m_live_first, m_live_last)
+      m_live_first = std::min(first, std::max(m_live_first, keep_first));
+      m_live_last = std::max(last, std::min(m_live_last, keep_last));
+    }
 
   private:
+    static const size_t ROW_MARGIN = 8;
     Gtk::Box m_vert_box;
+    Gtk::Layout m_layout;
     WindowData *m_controls_data;
+    std::vector<WidgetData *> m_rows; // top level widgets (or all in virtualized view)
+    base::LabelIndex  m_label_index;
+    std::vector<char> m_label_match, m_parent_match;
+    // (virtualized view)
+    std::vector<int> m_row_offsets; // see update_row_offsets()
+    int m_row_height;
+    int m_row_width;
+    size_t m_live_first, m_live_last;
 
     friend class MainWindow;
   };
@@ -3259,6 +8239,11 @@ namespace controls     // shl::gtk::controls
       m_menu_button.set_image_from_icon_name("open-menu-symbolic");
       m_header_right_box.pack_end(m_menu_button);
       //
+      m_search.set_placeholder_text("Search");
+      m_search.signal_search_changed().connect(
+              sigc::mem_fun(*this, &MainWindow::on_search_changed));
+      m_header_left_box.pack_start(m_search);
+      //
       this->set_titlebar(m_header);
       m_header.set_show_close_button(true);
       m_header.set_custom_title(m_title);
@@ -3283,6 +8268,13 @@ namespace controls     // shl::gtk::controls
       dialog.set_transient_for(*this);
       dialog.run();
     }
+    // -------------------------------------------------------------------------
+    // on_search_changed
+    // -------------------------------------------------------------------------
+    void on_search_changed()
+    {
+      m_view.set_filter(m_search.get_text().c_str());
+    }
     // ---------------------------------------------------------------------------
     // update (NOTE: need to be called from a GUI thread)
     // ---------------------------------------------------------------------------
@@ -3296,6 +8288,7 @@ namespace controls     // shl::gtk::controls
     Glib::RefPtr<Gio::SimpleActionGroup> m_action_group;
     Glib::RefPtr<Gio::Menu> m_gio_menu;
     Gtk::Box m_header_left_box;
+    Gtk::SearchEntry m_search;
     Gtk::Label m_title;
     Gtk::MenuButton m_menu_button;
     Gtk::Box m_header_right_box;
@@ -3343,12 +8336,87 @@ namespace controls     // shl::gtk::controls
       return get_window_num();
     }
     // -------------------------------------------------------------------------
+    // wait_user_event_for
+    // -------------------------------------------------------------------------
+    // [Note] returns the number of the opened windows (same as
+    // wait_user_event()). Use has_user_event() to check for the timeout
+    //
+    size_t wait_user_event_for(std::chrono::steady_clock::duration in_timeout)
+    {
+      get_user_event_queue()->wait_for(in_timeout);
+      return get_window_num();
+    }
+    // -------------------------------------------------------------------------
+    // wait_user_event_until
+    // -------------------------------------------------------------------------
+    size_t wait_user_event_until(std::chrono::steady_clock::time_point in_deadline)
+    {
+      get_user_event_queue()->wait_until(in_deadline);
+      return get_window_num();
+    }
+#ifdef SHL_GTK_COROUTINE
+    // -------------------------------------------------------------------------
+    // next_event
+    // -------------------------------------------------------------------------
+    // "co_await window.next_event()" is the coroutine version of
+    // wait_user_event(). Call process_widget_events() after resuming
+    // (get_window_num() == 0 tells the window close).
+    // [Note] without set_executor() the coroutine is resumed on the GTK
+    // thread (see set_executor)
+    //
+    base::EventQueue::EventAwaiter next_event()
+    {
+      return get_user_event_queue()->next_event(get_executor());
+    }
+#endif
+    // -------------------------------------------------------------------------
+    // has_user_event
+    // -------------------------------------------------------------------------
+    bool has_user_event()
+    {
+      return get_user_event_queue()->empty() == false;
+    }
+    // -------------------------------------------------------------------------
+    // get_user_event_fd
+    // -------------------------------------------------------------------------
+    // Returns a Linux eventfd that becomes readable while user events are
+    // pending (-1 if not supported). Add it to an existing epoll / poll loop
+    // and call process_widget_events() (or try_process_widget_events()) when
+    // it becomes readable. The fd is also signaled when the window is closed.
+    //
+    int get_user_event_fd()
+    {
+      return get_user_event_queue()->enable_event_fd();
+    }
+    // -------------------------------------------------------------------------
     // process_widget_events
     // -------------------------------------------------------------------------
     void process_widget_events(bool in_last_only = false)
     {
       get_user_event_queue()->process_events(in_last_only);
     }
+    // -------------------------------------------------------------------------
+    // process_widget_events
+    // -------------------------------------------------------------------------
+    // [Note] returns the number of the events left in the queue
+    //
+    size_t process_widget_events(size_t in_max_count,
+                                 std::chrono::steady_clock::duration in_max_time,
+                                 bool in_last_only = false)
+    {
+      return get_user_event_queue()->process_events(in_max_count, in_max_time,
+                                                    in_last_only);
+    }
+    // -------------------------------------------------------------------------
+    // try_process_widget_events
+    // -------------------------------------------------------------------------
+    // [Note] never blocks on the queue locks. returns the number of the events
+    // left in the queue
+    //
+    size_t try_process_widget_events(bool in_last_only = false)
+    {
+      return get_user_event_queue()->try_process(in_last_only);
+    }
 
   protected:
     // Member functions --------------------------------------------------------